@@ -54,11 +54,12 @@ class RoboCupBackend:
         self.flask_port = int(os.getenv('FLASK_PORT', '5001'))
         self.rcss_host = os.getenv('RCSS_HOST', '127.0.0.1')
         self.rcss_port = int(os.getenv('RCSS_PORT', '6000'))
+        self.wire_format = os.getenv('WIRE_FORMAT', 'json')  # json | binary | delta
         
         # Componentes
         self.adapter = RCSSAdapter()
         self.sim_manager = SimulationManager(self.rcss_host, self.rcss_port)
-        self.mqtt = MQTTClient(self.mqtt_host, self.mqtt_port)
+        self.mqtt = MQTTClient(self.mqtt_host, self.mqtt_port, wire_format=self.wire_format)
         self.flask = FlaskServer(self.flask_host, self.flask_port)
         
         # Estado
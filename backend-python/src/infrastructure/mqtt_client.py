@@ -11,6 +11,8 @@ from typing import Optional, Callable, Dict, Any
 
 import paho.mqtt.client as mqtt
 
+from src import wire_format
+
 logger = logging.getLogger(__name__)
 
 
@@ -22,17 +24,28 @@ class MQTTClient:
     - game/state/{device_id}: Backend -> Agente (sensores)
     - player/action/{device_id}: Agente -> Backend (acciones)
     - team/comm: Comunicación entre agentes
+    
+    Los estados se publican en JSON o en el formato binario de
+    src/wire_format.py según wire_format ("json" | "binary" | "delta"; delta
+    es binario con keyframes periódicos y deltas entre ellos). Las acciones
+    se aceptan en ambos formatos: se distinguen por el primer byte.
     """
     
     def __init__(
         self,
         broker_host: str = "localhost",
         broker_port: int = 1883,
-        client_id: str = "robocup_backend"
+        client_id: str = "robocup_backend",
+        wire_format: str = "json"
     ):
+        if wire_format not in ("json", "binary", "delta"):
+            raise ValueError(f"Unknown wire format: {wire_format}")
+        
         self.broker_host = broker_host
         self.broker_port = broker_port
         self.client_id = client_id
+        self.wire_format = wire_format
+        self._delta_encoders = {}  # device_id -> wire_format.DeltaEncoder
         
         # Usar callback API v2 con protocolo MQTT v3.1.1
         self.client = mqtt.Client(
@@ -72,7 +85,11 @@ class MQTTClient:
         """Callback al recibir un mensaje."""
         try:
             topic = msg.topic
-            payload = json.loads(msg.payload.decode())
+            
+            if topic.startswith("player/action/") and wire_format.is_binary(msg.payload):
+                payload = wire_format.decode_action(msg.payload)
+            else:
+                payload = json.loads(msg.payload.decode())
             
             if topic.startswith("player/action/"):
                 device_id = topic.split("/")[-1]
@@ -84,9 +101,11 @@ class MQTTClient:
                 if self.on_team_message:
                     self.on_team_message(payload)
                 logger.debug(f"Team message: {payload}")
-                
+        
         except json.JSONDecodeError as e:
             logger.error(f"Invalid JSON in message: {e}")
+        except wire_format.WireFormatError as e:
+            logger.error(f"Invalid binary message: {e}")
         except Exception as e:
             logger.error(f"Error processing message: {e}")
     
@@ -120,7 +139,13 @@ class MQTTClient:
             state: Estado con sensores en formato JSON
         """
         topic = f"game/state/{device_id}"
-        payload = json.dumps(state)
+        if self.wire_format == "delta":
+            encoder = self._delta_encoders.setdefault(device_id, wire_format.DeltaEncoder())
+            payload = encoder.encode(state)
+        elif self.wire_format == "binary":
+            payload = wire_format.encode_state(state)
+        else:
+            payload = json.dumps(state)
         self.client.publish(topic, payload, qos=1)
         logger.debug(f"Published state to {device_id}")
     
@@ -40,6 +40,14 @@ class FlagInfo:
     angle: float
 
 
+@dataclass
+class LineInfo:
+    """Información de una línea de borde visible (para el heading)."""
+    name: str       # "l t", "l b", "l l" o "l r"
+    distance: float
+    angle: float
+
+
 @dataclass
 class SensorData:
     """Datos consolidados de sensores."""
@@ -47,12 +55,15 @@ class SensorData:
     goal: Optional[GoalInfo] = None
     teammates: Optional[List[PlayerInfo]] = None
     flags: Optional[List[FlagInfo]] = None  # Banderas para triangulación
+    lines: Optional[List[LineInfo]] = None  # Líneas de borde para el heading
     
     def __post_init__(self):
         if self.teammates is None:
             self.teammates = []
         if self.flags is None:
             self.flags = []
+        if self.lines is None:
+            self.lines = []
 
 
 class RCSSAdapter:
@@ -80,6 +91,8 @@ class RCSSAdapter:
     FLAG_PATTERN = re.compile(r'\(\(f\s+([^)]+)\)\s+([\d.-]+)\s+([\d.-]+)')
     # Banderas de gol: ((g r) 30.0 10) o ((g l) 50.0 -20)
     GOAL_FLAG_PATTERN = re.compile(r'\(\(g\s+([rl])\)\s+([\d.-]+)\s+([\d.-]+)')
+    # Líneas de borde: ((l r) 20.5 -60)
+    LINE_PATTERN = re.compile(r'\(\(l\s+([tblr])\)\s+([\d.-]+)\s+([\d.-]+)')
 
     def parse_see(self, message: str) -> SensorData:
         """
@@ -89,12 +102,13 @@ class RCSSAdapter:
             message: Mensaje S-Expression del tipo (see time ...)
             
         Returns:
-            SensorData con información de bola, gol, jugadores y banderas visibles.
+            SensorData con información de bola, gol, jugadores, banderas y líneas visibles.
         """
         ball = None
         goal = None
         teammates = []
         flags = []
+        lines = []
 
         # Buscar bola
         ball_match = self.BALL_PATTERN.search(message)
@@ -136,7 +150,15 @@ class RCSSAdapter:
                 angle=float(goal_flag_match.group(3))
             ))
 
-        return SensorData(ball=ball, goal=goal, teammates=teammates, flags=flags)
+        # Buscar líneas de borde (l t), (l b), (l l), (l r)
+        for line_match in self.LINE_PATTERN.finditer(message):
+            lines.append(LineInfo(
+                name=f"l {line_match.group(1)}",
+                distance=float(line_match.group(2)),
+                angle=float(line_match.group(3))
+            ))
+
+        return SensorData(ball=ball, goal=goal, teammates=teammates, flags=flags, lines=lines)
 
     def parse_hear(self, message: str) -> Dict[str, Any]:
         """
@@ -235,6 +257,13 @@ class RCSSAdapter:
                 for f in sensor_data.flags
             ]
         
+        # Líneas de borde para el heading
+        if sensor_data.lines:
+            sensors['lines'] = [
+                {'name': l.name, 'dist': l.distance, 'angle': l.angle}
+                for l in sensor_data.lines
+            ]
+        
         return {
             'status': status,
             'role': role,
@@ -0,0 +1,357 @@
+"""
+Formato binario versionado para estados y acciones.
+
+Contraparte de common-cpp/include/wire_format.h: enteros little-endian,
+layout fijo por versión y distancias/ángulos en centésimas (int16). Un
+payload binario empieza con MAGIC (b'R'), por lo que se distingue de uno
+JSON (que empieza con '{') mirando el primer byte.
+
+Los estados usan el mismo dict que RCSSAdapter.to_json_sensors y las
+acciones el mismo que publica el agente ({"action": ..., "params": [...]}).
+
+Los deltas (encode_delta / apply_delta) trabajan sobre estados ya
+codificados: transmiten sólo las secciones y registros que cambiaron
+respecto de un keyframe identificado por su número de secuencia.
+"""
+
+import struct
+from typing import Any, Dict, List, Optional
+
+MAGIC = 0x52
+VERSION = 1
+
+KIND_SENSOR_DATA = 1
+KIND_ACTION = 2
+KIND_SENSOR_DELTA = 3
+
+# Límites de SensorData en messages.h
+MAX_TEAMMATES = 10
+MAX_FLAGS = 10
+MAX_LINES = 4
+
+SCALE = 100.0
+
+_HEADER = struct.Struct('<BBBB')
+_SENSOR_FIXED = struct.Struct('<BBBBBBBBBBhhhhHh')
+_RECORD = struct.Struct('<Bhh')
+_ACTION = struct.Struct('<BBBBBhh')
+
+SENSOR_FIXED_SIZE = _SENSOR_FIXED.size
+RECORD_SIZE = _RECORD.size
+DELTA_FIXED_SIZE = 6
+
+# Mensajes por keyframe en modo delta (~1.5 s al ritmo de publicación del backend)
+KEYFRAME_INTERVAL = 10
+
+# Tramos (offset, tamaño) de la parte fija que un delta envía si cambiaron:
+# status+role, presencia, ball, goal, stamina+speed. Luego las tres listas.
+_FIXED_SECTIONS = [(4, 2), (6, 1), (10, 4), (14, 4), (18, 4)]
+_COUNT_OFFSET = 7
+_LIST_MAX = [MAX_TEAMMATES, MAX_FLAGS, MAX_LINES]
+
+# Mismo orden que GameStatus, PlayerRole y ActionType en messages.h
+STATUSES = ['IDLE', 'BEFORE_KICK_OFF', 'PLAYING', 'FINISHED']
+ROLES = ['STRIKER', 'DRIBBLER', 'PASSER', 'RECEIVER', 'GOALKEEPER', 'DEFENDER', 'STRIKER_GK_SIM']
+ACTIONS = ['none', 'dash', 'turn', 'kick', 'catch', 'move']
+
+# Ids de field_flags.h: el índice en estas listas es el FlagId / LineId
+FLAG_NAMES = [
+    'f c', 'f c t', 'f c b',
+    'f l t', 'f l b', 'f r t', 'f r b',
+    'g l', 'g r', 'f g l t', 'f g l b', 'f g r t', 'f g r b',
+    'f p l t', 'f p l c', 'f p l b', 'f p r t', 'f p r c', 'f p r b',
+    'f t 0', 'f t l 10', 'f t l 20', 'f t l 30', 'f t l 40', 'f t l 50',
+    'f t r 10', 'f t r 20', 'f t r 30', 'f t r 40', 'f t r 50',
+    'f b 0', 'f b l 10', 'f b l 20', 'f b l 30', 'f b l 40', 'f b l 50',
+    'f b r 10', 'f b r 20', 'f b r 30', 'f b r 40', 'f b r 50',
+    'f l 0', 'f l t 10', 'f l t 20', 'f l t 30', 'f l b 10', 'f l b 20', 'f l b 30',
+    'f r 0', 'f r t 10', 'f r t 20', 'f r t 30', 'f r b 10', 'f r b 20', 'f r b 30',
+]
+LINE_NAMES = ['l t', 'l b', 'l l', 'l r']
+
+_FLAG_IDS = {name: i for i, name in enumerate(FLAG_NAMES)}
+_LINE_IDS = {name: i for i, name in enumerate(LINE_NAMES)}
+
+
+class WireFormatError(ValueError):
+    """Payload binario inválido o de otra versión."""
+
+
+def is_binary(payload: bytes) -> bool:
+    """True si el payload tiene la cabecera binaria (si no, es JSON)."""
+    return len(payload) >= _HEADER.size and payload[0] == MAGIC
+
+
+def _to_fixed(value: float) -> int:
+    """value * SCALE redondeado al más cercano y saturado a int16."""
+    scaled = float(value) * SCALE
+    rounded = int(scaled + 0.5) if scaled >= 0 else -int(-scaled + 0.5)
+    return max(-32768, min(32767, rounded))
+
+
+def _from_fixed(value: int) -> float:
+    return value / SCALE
+
+
+def sequence(payload: bytes) -> int:
+    """Número de secuencia del byte 3 de la cabecera."""
+    return payload[3]
+
+
+def encode_state(state: Dict[str, Any], sequence: int = 0) -> bytes:
+    """
+    Codifica un estado con el formato de RCSSAdapter.to_json_sensors.
+    
+    Los arrays se truncan a los límites del agente y las banderas o
+    líneas con nombre desconocido se omiten, igual que al decodificar JSON.
+    """
+    sensors = state.get('sensors') or {}
+    ball = sensors.get('ball')
+    goal = sensors.get('goal')
+    
+    teammates = [
+        (int(t['id']), t['dist'], t['angle'])
+        for t in (sensors.get('teammates') or [])
+    ][:MAX_TEAMMATES]
+    flags = [
+        (_FLAG_IDS[f['name']], f['dist'], f['angle'])
+        for f in (sensors.get('flags') or []) if f['name'] in _FLAG_IDS
+    ][:MAX_FLAGS]
+    lines = [
+        (_LINE_IDS[l['name']], l['dist'], l['angle'])
+        for l in (sensors.get('lines') or []) if l['name'] in _LINE_IDS
+    ][:MAX_LINES]
+    
+    status = state.get('status', 'IDLE')
+    role = state.get('role', 'STRIKER')
+    presence = (1 if ball else 0) | (2 if goal else 0)
+    
+    out = bytearray(_SENSOR_FIXED.pack(
+        MAGIC, VERSION, KIND_SENSOR_DATA, sequence & 0xFF,
+        STATUSES.index(status) if status in STATUSES else 0,
+        ROLES.index(role) if role in ROLES else 0,
+        presence, len(teammates), len(flags), len(lines),
+        _to_fixed(ball['dist']) if ball else 0,
+        _to_fixed(ball['angle']) if ball else 0,
+        _to_fixed(goal['dist']) if goal else 0,
+        _to_fixed(goal['angle']) if goal else 0,
+        max(0, min(65535, int(state.get('stamina', 8000)))),
+        _to_fixed(state.get('speed', 0.0)),
+    ))
+    for record_id, dist, angle in teammates + flags + lines:
+        out += _RECORD.pack(record_id, _to_fixed(dist), _to_fixed(angle))
+    return bytes(out)
+
+
+def _lists(payload: bytes) -> List[List[bytes]]:
+    """Registros (5 bytes c/u) de teammates, flags y lines."""
+    out = []
+    offset = SENSOR_FIXED_SIZE
+    for i in range(3):
+        count = payload[_COUNT_OFFSET + i]
+        out.append([payload[offset + RECORD_SIZE * j:offset + RECORD_SIZE * (j + 1)] for j in range(count)])
+        offset += RECORD_SIZE * count
+    return out
+
+
+def _find_record(records: List[bytes], record_id: int) -> Optional[bytes]:
+    return next((r for r in records if r[0] == record_id), None)
+
+
+def encode_delta(keyframe: bytes, current: bytes, sequence: int) -> bytes:
+    """
+    Delta de current respecto de keyframe (ambos de encode_state).
+    
+    La secuencia del keyframe se toma de su cabecera; sequence es la de
+    este mensaje.
+    """
+    _check_state(keyframe)
+    _check_state(current)
+    
+    mask = 0
+    body = bytearray()
+    for bit, (offset, size) in enumerate(_FIXED_SECTIONS):
+        if keyframe[offset:offset + size] != current[offset:offset + size]:
+            mask |= 1 << bit
+            body += current[offset:offset + size]
+    
+    for i, (kf_records, cur_records) in enumerate(zip(_lists(keyframe), _lists(current))):
+        if kf_records == cur_records:
+            continue
+        mask |= 1 << (len(_FIXED_SECTIONS) + i)
+        full = 0
+        entries = bytearray()
+        for j, record in enumerate(cur_records):
+            if _find_record(kf_records, record[0]) == record:
+                entries.append(record[0])
+            else:
+                full |= 1 << j
+                entries += record
+        body += struct.pack('<BH', len(cur_records), full) + entries
+    
+    header = _HEADER.pack(MAGIC, VERSION, KIND_SENSOR_DELTA, sequence & 0xFF)
+    return header + bytes([keyframe[3], mask]) + bytes(body)
+
+
+def apply_delta(keyframe: bytes, delta: bytes) -> bytes:
+    """Estado completo (con la secuencia del delta) a partir del keyframe."""
+    _check_state(keyframe)
+    _check_header(delta, KIND_SENSOR_DELTA)
+    if len(delta) < DELTA_FIXED_SIZE:
+        raise WireFormatError("truncated delta")
+    if delta[4] != keyframe[3]:
+        raise WireFormatError(f"delta for keyframe {delta[4]}, have {keyframe[3]}")
+    
+    out = bytearray(keyframe[:SENSOR_FIXED_SIZE])
+    out[3] = delta[3]
+    mask = delta[5]
+    pos = DELTA_FIXED_SIZE
+    for bit, (offset, size) in enumerate(_FIXED_SECTIONS):
+        if mask & (1 << bit):
+            if len(delta) < pos + size:
+                raise WireFormatError("truncated delta")
+            out[offset:offset + size] = delta[pos:pos + size]
+            pos += size
+    
+    records = bytearray()
+    for i, kf_records in enumerate(_lists(keyframe)):
+        if not mask & (1 << (len(_FIXED_SECTIONS) + i)):
+            out[_COUNT_OFFSET + i] = len(kf_records)
+            records += b''.join(kf_records)
+            continue
+        if len(delta) < pos + 3:
+            raise WireFormatError("truncated delta")
+        count, full = struct.unpack_from('<BH', delta, pos)
+        pos += 3
+        if count > _LIST_MAX[i]:
+            raise WireFormatError("field out of range")
+        for j in range(count):
+            if full & (1 << j):
+                record = delta[pos:pos + RECORD_SIZE]
+                pos += RECORD_SIZE
+            else:
+                record = _find_record(kf_records, delta[pos]) if pos < len(delta) else None
+                pos += 1
+            if record is None or len(record) != RECORD_SIZE:
+                raise WireFormatError("bad record reference")
+            records += record
+        out[_COUNT_OFFSET + i] = count
+    
+    if pos != len(delta):
+        raise WireFormatError("size does not match sections")
+    result = bytes(out + records)
+    _check_state(result)
+    return result
+
+
+class DeltaEncoder:
+    """
+    Codifica los estados sucesivos de un dispositivo como keyframes + deltas.
+    
+    Envía un keyframe cada keyframe_interval mensajes (para que un agente
+    que se conecta o pierde un keyframe se recupere) y también cuando el
+    delta no resulta más chico que el estado completo.
+    """
+    
+    def __init__(self, keyframe_interval: int = KEYFRAME_INTERVAL):
+        self.keyframe_interval = keyframe_interval
+        self._sequence = 0
+        self._keyframe: Optional[bytes] = None
+        self._since_keyframe = 0
+    
+    def encode(self, state: Dict[str, Any]) -> bytes:
+        self._sequence = (self._sequence + 1) & 0xFF
+        full = encode_state(state, self._sequence)
+        if self._keyframe is not None and self._since_keyframe < self.keyframe_interval - 1:
+            delta = encode_delta(self._keyframe, full, self._sequence)
+            if len(delta) < len(full):
+                self._since_keyframe += 1
+                return delta
+        self._keyframe = full
+        self._since_keyframe = 0
+        return full
+
+
+def _check_header(payload: bytes, kind: int) -> None:
+    if not is_binary(payload):
+        raise WireFormatError("missing binary header")
+    _, version, payload_kind, _ = _HEADER.unpack_from(payload)
+    if version != VERSION:
+        raise WireFormatError(f"unsupported version {version}")
+    if payload_kind != kind:
+        raise WireFormatError(f"unexpected kind {payload_kind}")
+
+
+def _check_state(payload: bytes) -> None:
+    """Cabecera, rangos de los enums y tamaño coherente con los contadores."""
+    _check_header(payload, KIND_SENSOR_DATA)
+    if len(payload) < _SENSOR_FIXED.size:
+        raise WireFormatError("truncated state")
+    status, role, _, teammate_count, flag_count, line_count = payload[4:10]
+    if (status >= len(STATUSES) or role >= len(ROLES) or teammate_count > MAX_TEAMMATES
+            or flag_count > MAX_FLAGS or line_count > MAX_LINES):
+        raise WireFormatError("field out of range")
+    record_count = teammate_count + flag_count + line_count
+    if len(payload) != _SENSOR_FIXED.size + _RECORD.size * record_count:
+        raise WireFormatError("size does not match counts")
+
+
+def decode_state(payload: bytes) -> Dict[str, Any]:
+    """Decodifica un estado al mismo dict que RCSSAdapter.to_json_sensors."""
+    _check_state(payload)
+    
+    (_, _, _, _, status, role, presence, teammate_count, flag_count, line_count,
+     ball_dist, ball_angle, goal_dist, goal_angle, _, _) = _SENSOR_FIXED.unpack_from(payload)
+    record_count = teammate_count + flag_count + line_count
+    
+    records: List[tuple] = [
+        _RECORD.unpack_from(payload, _SENSOR_FIXED.size + _RECORD.size * i)
+        for i in range(record_count)
+    ]
+    
+    sensors: Dict[str, Any] = {}
+    if presence & 1:
+        sensors['ball'] = {'dist': _from_fixed(ball_dist), 'angle': _from_fixed(ball_angle)}
+    if presence & 2:
+        sensors['goal'] = {'dist': _from_fixed(goal_dist), 'angle': _from_fixed(goal_angle)}
+    if teammate_count:
+        sensors['teammates'] = [
+            {'id': i, 'dist': _from_fixed(d), 'angle': _from_fixed(a)}
+            for i, d, a in records[:teammate_count]
+        ]
+    flags = records[teammate_count:teammate_count + flag_count]
+    if flags:
+        sensors['flags'] = [
+            {'name': FLAG_NAMES[i], 'dist': _from_fixed(d), 'angle': _from_fixed(a)}
+            for i, d, a in flags if i < len(FLAG_NAMES)
+        ]
+    lines = records[teammate_count + flag_count:]
+    if lines:
+        sensors['lines'] = [
+            {'name': LINE_NAMES[i], 'dist': _from_fixed(d), 'angle': _from_fixed(a)}
+            for i, d, a in lines if i < len(LINE_NAMES)
+        ]
+    
+    return {'status': STATUSES[status], 'role': ROLES[role], 'sensors': sensors}
+
+
+def encode_action(action: Dict[str, Any]) -> bytes:
+    """Codifica {"action": nombre, "params": [p0, p1]}."""
+    name = action.get('action', 'none')
+    params = list(action.get('params') or []) + [0.0, 0.0]
+    return _ACTION.pack(
+        MAGIC, VERSION, KIND_ACTION, 0,
+        ACTIONS.index(name) if name in ACTIONS else 0,
+        _to_fixed(params[0]), _to_fixed(params[1]),
+    )
+
+
+def decode_action(payload: bytes) -> Dict[str, Any]:
+    """Decodifica una acción al dict que publica el agente en JSON."""
+    _check_header(payload, KIND_ACTION)
+    if len(payload) != _ACTION.size:
+        raise WireFormatError("wrong action size")
+    _, _, _, _, action_type, p0, p1 = _ACTION.unpack(payload)
+    if action_type >= len(ACTIONS):
+        raise WireFormatError(f"unknown action {action_type}")
+    return {'action': ACTIONS[action_type], 'params': [_from_fixed(p0), _from_fixed(p1)]}
@@ -5,7 +5,7 @@ Siguiendo TDD: Primero los tests (RED), luego la implementación (GREEN).
 """
 
 import pytest
-from src.rcss_adapter import RCSSAdapter, SensorData, BallInfo, GoalInfo, PlayerInfo
+from src.rcss_adapter import RCSSAdapter, SensorData, BallInfo, GoalInfo, PlayerInfo, LineInfo
 
 
 class TestSExpressionParser:
@@ -55,6 +55,17 @@ class TestSExpressionParser:
         assert result.teammates[0].player_id == 2
         assert result.teammates[0].distance == pytest.approx(5.0, rel=0.1)
 
+    def test_parse_see_message_with_lines(self):
+        """Debe parsear las líneas de borde sin confundirlas con banderas."""
+        see_msg = "(see 100 ((f r t) 30.0 20) ((l r) 20.5 -60) ((l t) 12.1 85))"
+        
+        result = self.adapter.parse_see(see_msg)
+        
+        assert len(result.flags) == 1
+        assert [l.name for l in result.lines] == ["l r", "l t"]
+        assert result.lines[0].distance == pytest.approx(20.5)
+        assert result.lines[0].angle == pytest.approx(-60.0)
+
     def test_parse_hear_message(self):
         """Debe parsear mensajes de comunicación entre jugadores."""
         hear_msg = '(hear 100 2 "PASSING")'
@@ -87,6 +98,15 @@ class TestSExpressionParser:
         assert json_output['role'] == "STRIKER"
         assert json_output['sensors']['ball']['dist'] == pytest.approx(10.5, rel=0.1)
         assert json_output['sensors']['ball']['angle'] == pytest.approx(-15.0, rel=0.1)
+        assert 'lines' not in json_output['sensors']
+
+    def test_convert_lines_to_json_sensors(self):
+        """Debe incluir las líneas visibles en el JSON para el agente."""
+        sensor_data = SensorData(lines=[LineInfo(name="l r", distance=20.5, angle=-60.0)])
+        
+        json_output = self.adapter.to_json_sensors(sensor_data, role="STRIKER", status="PLAYING")
+        
+        assert json_output['sensors']['lines'] == [{'name': 'l r', 'dist': 20.5, 'angle': -60.0}]
 
 
 class TestRCSSCommands:
@@ -0,0 +1,191 @@
+"""
+Tests para el formato binario de estados y acciones.
+
+Los bytes esperados deben coincidir con common-cpp/include/wire_format.h.
+"""
+
+import pytest
+from src import wire_format
+from src.wire_format import WireFormatError
+
+
+def sample_state():
+    return {
+        'status': 'PLAYING',
+        'role': 'GOALKEEPER',
+        'sensors': {
+            'ball': {'dist': 10.5, 'angle': -15.0},
+            'teammates': [{'id': 7, 'dist': 5.2, 'angle': 20.0}],
+            'flags': [
+                {'name': 'f c', 'dist': 15.2, 'angle': 30.0},
+                {'name': 'f r b 30', 'dist': 40.4, 'angle': -12.0},
+            ],
+            'lines': [{'name': 'l r', 'dist': 20.5, 'angle': -60.0}],
+        },
+    }
+
+
+class TestStateCodec:
+    """Tests de codificación de estados."""
+    
+    def test_header_and_size(self):
+        """Cabecera 'R', versión 1, tipo 1 y 5 bytes por registro."""
+        payload = wire_format.encode_state(sample_state())
+        
+        assert payload[:4] == bytes([0x52, 1, 1, 0])
+        assert len(payload) == 22 + 5 * 4
+        assert wire_format.is_binary(payload)
+    
+    def test_round_trip(self):
+        """Decodificar devuelve el mismo dict que to_json_sensors."""
+        decoded = wire_format.decode_state(wire_format.encode_state(sample_state()))
+        
+        assert decoded == sample_state()
+    
+    def test_fixed_layout(self):
+        """Enums, presencia y valores en centésimas little-endian."""
+        payload = wire_format.encode_state(sample_state())
+        
+        assert payload[4] == 2          # PLAYING
+        assert payload[5] == 4          # GOALKEEPER
+        assert payload[6] == 1          # Sólo balón
+        assert payload[7:10] == bytes([1, 2, 1])
+        assert payload[10:12] == (1050).to_bytes(2, 'little')
+        assert payload[12:14] == (-1500).to_bytes(2, 'little', signed=True)
+        # Registro de 'f r b 30' (FlagId 54)
+        assert payload[32] == 54
+    
+    def test_quantization_rounds_and_saturates(self):
+        """Redondeo al centésimo más cercano y saturación a int16."""
+        state = {'status': 'PLAYING', 'role': 'STRIKER',
+                 'sensors': {'ball': {'dist': 0.126, 'angle': -0.125},
+                             'goal': {'dist': 500.0, 'angle': -400.0}}}
+        
+        sensors = wire_format.decode_state(wire_format.encode_state(state))['sensors']
+        
+        assert sensors['ball']['dist'] == pytest.approx(0.13)
+        assert sensors['ball']['angle'] == pytest.approx(-0.13)
+        assert sensors['goal']['dist'] == pytest.approx(327.67)
+        assert sensors['goal']['angle'] == pytest.approx(-327.68)
+    
+    def test_empty_sensors(self):
+        """El estado mínimo del broadcast del referee ocupa 22 bytes."""
+        state = {'status': 'BEFORE_KICK_OFF', 'role': 'DEFENDER', 'sensors': {}}
+        
+        payload = wire_format.encode_state(state)
+        
+        assert len(payload) == 22
+        assert wire_format.decode_state(payload) == state
+    
+    def test_unknown_flags_are_dropped(self):
+        """Las banderas sin id en field_flags.h no se codifican."""
+        state = sample_state()
+        state['sensors']['flags'].append({'name': 'f x', 'dist': 1.0, 'angle': 0.0})
+        
+        decoded = wire_format.decode_state(wire_format.encode_state(state))
+        
+        assert len(decoded['sensors']['flags']) == 2
+    
+    def test_rejects_bad_payloads(self):
+        """Versión, tipo y tamaño deben coincidir."""
+        payload = bytearray(wire_format.encode_state(sample_state()))
+        
+        with pytest.raises(WireFormatError):
+            wire_format.decode_state(bytes(payload[:-1]))
+        with pytest.raises(WireFormatError):
+            wire_format.decode_state(b'{"status": "PLAYING"}')
+        
+        payload[1] = 2
+        with pytest.raises(WireFormatError):
+            wire_format.decode_state(bytes(payload))
+        
+        payload[1] = 1
+        payload[2] = wire_format.KIND_ACTION
+        with pytest.raises(WireFormatError):
+            wire_format.decode_state(bytes(payload))
+
+
+class TestActionCodec:
+    """Tests de codificación de acciones."""
+    
+    def test_round_trip(self):
+        """Nueve bytes: cabecera, tipo y dos parámetros."""
+        action = {'action': 'kick', 'params': [100.0, -45.5]}
+        
+        payload = wire_format.encode_action(action)
+        
+        assert len(payload) == 9
+        assert payload[4] == 3
+        assert wire_format.decode_action(payload) == action
+    
+    def test_missing_params_default_to_zero(self):
+        """turn lleva un solo parámetro en JSON."""
+        payload = wire_format.encode_action({'action': 'turn', 'params': [30.0]})
+        
+        assert wire_format.decode_action(payload) == {'action': 'turn', 'params': [30.0, 0.0]}
+    
+    def test_rejects_unknown_action(self):
+        """Un tipo fuera de ActionType es un error."""
+        payload = bytearray(wire_format.encode_action({'action': 'dash', 'params': [80.0, 0.0]}))
+        payload[4] = 9
+        
+        with pytest.raises(WireFormatError):
+            wire_format.decode_action(bytes(payload))
+    
+    def test_json_is_not_binary(self):
+        """Un payload JSON nunca empieza con MAGIC."""
+        assert not wire_format.is_binary(b'{"action":"dash","params":[80.0,0.0]}')
+
+
+class TestDeltaCodec:
+    """Tests de deltas respecto de un keyframe."""
+    
+    def test_static_scene_is_header_only(self):
+        """Sin cambios el delta ocupa 6 bytes y referencia al keyframe."""
+        keyframe = wire_format.encode_state(sample_state(), sequence=7)
+        current = wire_format.encode_state(sample_state(), sequence=8)
+        
+        delta = wire_format.encode_delta(keyframe, current, 8)
+        
+        assert delta == bytes([0x52, 1, wire_format.KIND_SENSOR_DELTA, 8, 7, 0])
+        assert wire_format.apply_delta(keyframe, delta) == current
+    
+    def test_sends_only_changed_fields_and_records(self):
+        """Mismos bytes que WireDeltaTest.SendsOnlyChangedFieldsAndRecords en C++."""
+        after = sample_state()
+        after['sensors']['ball'] = {'dist': 9.8, 'angle': -14.0}
+        after['sensors']['flags'][1]['dist'] = 39.9
+        after['sensors']['flags'].append({'name': 'g r', 'dist': 30.0, 'angle': 5.0})
+        del after['sensors']['lines']
+        keyframe = wire_format.encode_state(sample_state(), sequence=1)
+        current = wire_format.encode_state(after, sequence=2)
+        
+        delta = wire_format.encode_delta(keyframe, current, 2)
+        
+        assert delta[5] == 0x04 | 0x40 | 0x80
+        assert len(delta) == 6 + 4 + (3 + 1 + 2 * 5) + 3
+        assert wire_format.apply_delta(keyframe, delta) == current
+        assert wire_format.decode_state(wire_format.apply_delta(keyframe, delta)) == after
+    
+    def test_rejects_delta_for_another_keyframe(self):
+        """Un delta sólo se aplica sobre el keyframe con su secuencia."""
+        keyframe = wire_format.encode_state(sample_state(), sequence=10)
+        other = wire_format.encode_state(sample_state(), sequence=11)
+        delta = wire_format.encode_delta(keyframe, keyframe, 12)
+        
+        with pytest.raises(WireFormatError):
+            wire_format.apply_delta(other, delta)
+        with pytest.raises(WireFormatError):
+            wire_format.apply_delta(keyframe, delta[:-1] + bytes([0x40]))
+    
+    def test_encoder_sends_periodic_keyframes(self):
+        """Un keyframe cada keyframe_interval mensajes y deltas en medio."""
+        encoder = wire_format.DeltaEncoder(keyframe_interval=3)
+        
+        payloads = [encoder.encode(sample_state()) for _ in range(7)]
+        
+        kinds = [p[2] for p in payloads]
+        assert kinds == [1, 3, 3, 1, 3, 3, 1]
+        assert [wire_format.sequence(p) for p in payloads] == [1, 2, 3, 4, 5, 6, 7]
+        assert payloads[2][4] == 1  # Referencia al primer keyframe
+        assert wire_format.decode_state(wire_format.apply_delta(payloads[3], payloads[5])) == sample_state()
@@ -0,0 +1,165 @@
+/**
+ * @file bench_sensor_json.cpp
+ * @brief Tiempo de decodificación del estado JSON: parser anterior vs SensorJson.
+ *
+ * Genera payloads con el mismo formato que json.dumps en el backend
+ * (separadores ", " y ": ") a partir de poses sintéticas: balón, arco,
+ * algunos compañeros y las banderas visibles. Reporta ns/mensaje, la
+ * latencia por mensaje y verifica que ambos decodificadores coincidan.
+ *
+ * Uso: bench_sensor_json [--messages N] [--seed S]
+ */
+
+#include "sensor_json.h"
+#include "bench_stats.h"
+#include "legacy_sensor_parser.h"
+#include "synthetic_field.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace robocup;
+using namespace robocup::bench;
+
+namespace {
+
+void append(std::string& out, const char* fmt, float a, float b) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), fmt, a, b);
+    out += buffer;
+}
+
+std::string make_payload(const Sample& s, std::mt19937& rng) {
+    std::uniform_real_distribution<float> dist(1.0f, 40.0f);
+    std::uniform_int_distribution<int> angle(-45, 45);
+    std::uniform_int_distribution<int> teammates(0, 3);
+    
+    std::string out = "{\"status\": \"PLAYING\", \"role\": \"STRIKER\", \"sensors\": {";
+    append(out, "\"ball\": {\"dist\": %.1f, \"angle\": %.1f}, ", dist(rng), static_cast<float>(angle(rng)));
+    append(out, "\"goal\": {\"dist\": %.1f, \"angle\": %.1f}, ", dist(rng), static_cast<float>(angle(rng)));
+    
+    out += "\"teammates\": [";
+    int count = teammates(rng);
+    for (int i = 0; i < count; ++i) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), "%s{\"id\": %d, \"dist\": %.1f, \"angle\": %.1f}",
+                      i ? ", " : "", i + 2, dist(rng), static_cast<float>(angle(rng)));
+        out += buffer;
+    }
+    out += "], \"flags\": [";
+    for (uint8_t i = 0; i < s.flag_count; ++i) {
+        out += i ? ", {\"name\": \"" : "{\"name\": \"";
+        out += FieldFlags::get(s.flags[i].id).name;
+        append(out, "\", \"dist\": %.1f, \"angle\": %.1f}", s.flags[i].distance, s.flags[i].angle);
+    }
+    out += "]}}";
+    return out;
+}
+
+bool same(const SensorData& a, const SensorData& b) {
+    if (a.status != b.status || a.role != b.role || a.flag_count != b.flag_count ||
+        a.ball.visible != b.ball.visible || a.ball.distance != b.ball.distance ||
+        a.goal.angle != b.goal.angle) {
+        return false;
+    }
+    for (uint8_t i = 0; i < a.flag_count; ++i) {
+        if (a.flags[i].id != b.flags[i].id || a.flags[i].distance != b.flags[i].distance ||
+            a.flags[i].angle != b.flags[i].angle) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Result {
+    const char* name = "";
+    double ns_per_message = 0;
+    Distribution latency;
+};
+
+Result run(const char* name, const std::vector<std::string>& payloads,
+           const std::function<uint8_t(const std::string&)>& decode) {
+    Result r;
+    r.name = name;
+    r.latency.reserve(payloads.size());
+    
+    unsigned sink = 0;
+    for (const std::string& p : payloads) sink += decode(p);
+    Clock::time_point start = Clock::now();
+    for (const std::string& p : payloads) sink += decode(p);
+    r.ns_per_message = elapsed_ns(start, Clock::now()) / payloads.size();
+    
+    for (const std::string& p : payloads) {
+        Clock::time_point t0 = Clock::now();
+        sink += decode(p);
+        r.latency.add(elapsed_ns(t0, Clock::now()));
+    }
+    if (sink == 0x12345678u) std::printf(" ");  // Evita que se elimine el cálculo
+    return r;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    size_t message_count = 50000;
+    uint32_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--messages") == 0 && i + 1 < argc) {
+            message_count = std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "Uso: %s [--messages N] [--seed S]\n", argv[0]);
+            return 1;
+        }
+    }
+    
+    FieldSampler sampler(seed);
+    std::mt19937 rng(seed);
+    std::vector<std::string> payloads;
+    payloads.reserve(message_count);
+    size_t bytes = 0;
+    for (size_t i = 0; i < message_count; ++i) {
+        payloads.push_back(make_payload(sampler.next(), rng));
+        bytes += payloads.back().size();
+    }
+    
+    size_t mismatches = 0;
+    for (const std::string& p : payloads) {
+        SensorData decoded;
+        if (!SensorJson::decode(p, decoded) || !same(decoded, legacy_parse_sensors(p))) {
+            mismatches++;
+        }
+    }
+    
+    std::printf("Sensor JSON benchmark: %zu messages, %.0f bytes/message, seed %u\n",
+                message_count, static_cast<double>(bytes) / message_count, seed);
+    std::printf("Decoders disagree on %zu messages\n", mismatches);
+    
+    std::vector<Result> results;
+    results.push_back(run("find + stof (before)", payloads, [](const std::string& p) {
+        return legacy_parse_sensors(p).flag_count;
+    }));
+    results.push_back(run("SensorJson::decode", payloads, [](const std::string& p) {
+        SensorData sensors;
+        SensorJson::decode(p, sensors);
+        return sensors.flag_count;
+    }));
+    
+    std::printf("\n%-22s %10s %10s\n", "", "ns/msg", "MB/s");
+    for (Result& r : results) {
+        double mb_per_s = (static_cast<double>(bytes) / message_count) / r.ns_per_message * 1e3;
+        std::printf("%-22s %10.1f %10.1f\n", r.name, r.ns_per_message, mb_per_s);
+    }
+    
+    print_header("Latency (ns/message)");
+    for (Result& r : results) print_row(r.name, r.latency);
+    
+    return mismatches == 0 ? 0 : 1;
+}
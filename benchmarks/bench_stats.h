@@ -0,0 +1,72 @@
+#ifndef ROBOCUP_BENCH_STATS_H
+#define ROBOCUP_BENCH_STATS_H
+
+/**
+ * @file bench_stats.h
+ * @brief Medición de latencia y resumen de distribuciones para los benchmarks.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace robocup {
+namespace bench {
+
+using Clock = std::chrono::steady_clock;
+
+inline double elapsed_ns(Clock::time_point start, Clock::time_point end) {
+    return std::chrono::duration<double, std::nano>(end - start).count();
+}
+
+/**
+ * @brief Muestras de una magnitud con percentiles.
+ */
+class Distribution {
+public:
+    void reserve(size_t n) { values_.reserve(n); }
+    void add(double v) { values_.push_back(v); }
+    size_t size() const { return values_.size(); }
+    
+    double mean() const {
+        if (values_.empty()) return 0;
+        double sum = 0;
+        for (double v : values_) sum += v;
+        return sum / values_.size();
+    }
+    
+    /**
+     * @param p Percentil en [0, 100] (nearest-rank)
+     */
+    double percentile(double p) {
+        if (values_.empty()) return 0;
+        if (!sorted_) {
+            std::sort(values_.begin(), values_.end());
+            sorted_ = true;
+        }
+        size_t rank = static_cast<size_t>(p / 100.0 * (values_.size() - 1) + 0.5);
+        return values_[rank];
+    }
+    
+    double max() { return percentile(100); }
+
+private:
+    std::vector<double> values_;
+    bool sorted_ = false;
+};
+
+inline void print_header(const char* title) {
+    std::printf("\n%s\n", title);
+    std::printf("%-22s %10s %10s %10s %10s %10s\n", "", "mean", "p50", "p95", "p99", "max");
+}
+
+inline void print_row(const char* label, Distribution& d) {
+    std::printf("%-22s %10.4g %10.4g %10.4g %10.4g %10.4g\n", label,
+                d.mean(), d.percentile(50), d.percentile(95), d.percentile(99), d.max());
+}
+
+} // namespace bench
+} // namespace robocup
+
+#endif // ROBOCUP_BENCH_STATS_H
@@ -0,0 +1,168 @@
+#ifndef ROBOCUP_BENCH_LEGACY_SENSOR_PARSER_H
+#define ROBOCUP_BENCH_LEGACY_SENSOR_PARSER_H
+
+/**
+ * @file legacy_sensor_parser.h
+ * @brief Parser de estado anterior de main_pc.cpp (find + substr + stof).
+ *
+ * Copia sin cambios del MQTTAgent::parse_sensors reemplazado por
+ * SensorJson::decode; sólo se conserva como referencia del "antes" en
+ * bench_sensor_json.
+ */
+
+#include "messages.h"
+#include "field_flags.h"
+#include <string>
+
+namespace robocup {
+namespace bench {
+
+inline robocup::SensorData legacy_parse_sensors(const std::string& json) {
+    robocup::SensorData sensors;
+    
+    // Parseo muy básico de status
+    if (json.find("\"PLAYING\"") != std::string::npos || 
+        json.find("\"play_on\"") != std::string::npos) {
+        sensors.status = robocup::GameStatus::PLAYING;
+    } else if (json.find("\"BEFORE_KICK_OFF\"") != std::string::npos ||
+               json.find("\"before_kick_off\"") != std::string::npos ||
+               json.find("\"kick_off_l\"") != std::string::npos ||
+               json.find("\"kick_off_r\"") != std::string::npos) {
+        sensors.status = robocup::GameStatus::BEFORE_KICK_OFF;
+    } else if (json.find("\"FINISHED\"") != std::string::npos) {
+        sensors.status = robocup::GameStatus::FINISHED;
+    }
+    
+    // IMPORTANTE: STRIKER_GK_SIM debe ir ANTES de STRIKER porque contiene "STRIKER"
+    if (json.find("\"STRIKER_GK_SIM\"") != std::string::npos) {
+        sensors.role = robocup::PlayerRole::STRIKER_GK_SIM;
+    } else if (json.find("\"STRIKER\"") != std::string::npos) {
+        sensors.role = robocup::PlayerRole::STRIKER;
+    } else if (json.find("\"GOALKEEPER\"") != std::string::npos) {
+        sensors.role = robocup::PlayerRole::GOALKEEPER;
+    } else if (json.find("\"DRIBBLER\"") != std::string::npos) {
+        sensors.role = robocup::PlayerRole::DRIBBLER;
+    } else if (json.find("\"DEFENDER\"") != std::string::npos) {
+        sensors.role = robocup::PlayerRole::DEFENDER;
+    } else if (json.find("\"PASSER\"") != std::string::npos) {
+        sensors.role = robocup::PlayerRole::PASSER;
+    } else if (json.find("\"RECEIVER\"") != std::string::npos) {
+        sensors.role = robocup::PlayerRole::RECEIVER;
+    }
+    
+    // Parsear ball distance/angle
+    size_t ball_pos = json.find("\"ball\"");
+    if (ball_pos != std::string::npos) {
+        size_t dist_pos = json.find("\"dist\"", ball_pos);
+        size_t angle_pos = json.find("\"angle\"", ball_pos);
+        if (dist_pos != std::string::npos && angle_pos != std::string::npos) {
+            sensors.ball.visible = true;
+            // Parseo simplificado - extraer números
+            size_t colon = json.find(":", dist_pos);
+            if (colon != std::string::npos) {
+                sensors.ball.distance = std::stof(json.substr(colon + 1, 10));
+            }
+            colon = json.find(":", angle_pos);
+            if (colon != std::string::npos) {
+                sensors.ball.angle = std::stof(json.substr(colon + 1, 10));
+            }
+        }
+    }
+    
+    // Parsear goal distance/angle
+    size_t goal_pos = json.find("\"goal\"");
+    if (goal_pos != std::string::npos) {
+        size_t dist_pos = json.find("\"dist\"", goal_pos);
+        size_t angle_pos = json.find("\"angle\"", goal_pos);
+        if (dist_pos != std::string::npos && angle_pos != std::string::npos) {
+            sensors.goal.visible = true;
+            size_t colon = json.find(":", dist_pos);
+            if (colon != std::string::npos) {
+                sensors.goal.distance = std::stof(json.substr(colon + 1, 10));
+            }
+            colon = json.find(":", angle_pos);
+            if (colon != std::string::npos) {
+                sensors.goal.angle = std::stof(json.substr(colon + 1, 10));
+            }
+        }
+    }
+    
+    // Parsear flags para triangulación
+    sensors.flag_count = 0;
+    size_t flags_pos = json.find("\"flags\"");
+    if (flags_pos != std::string::npos) {
+        // Buscar cada bandera en el array
+        size_t search_start = flags_pos;
+        while (sensors.flag_count < robocup::SensorData::MAX_FLAGS) {
+            size_t name_pos = json.find("\"name\"", search_start);
+            if (name_pos == std::string::npos || name_pos > json.find("]", flags_pos)) break;
+            
+            // Extraer nombre y resolverlo a FlagId (sin copiarlo)
+            size_t name_start = json.find("\"", name_pos + 6) + 1;
+            size_t name_end = json.find("\"", name_start);
+            robocup::FlagId id = robocup::FieldFlags::find(
+                json.data() + name_start, name_end - name_start);
+            
+            // Extraer dist y angle
+            size_t dist_pos = json.find("\"dist\"", name_end);
+            size_t angle_pos = json.find("\"angle\"", name_end);
+            
+            if (id != robocup::FlagId::UNKNOWN &&
+                dist_pos != std::string::npos && angle_pos != std::string::npos) {
+                robocup::FlagInfo& flag = sensors.flags[sensors.flag_count];
+                flag.id = id;
+                
+                size_t colon = json.find(":", dist_pos);
+                if (colon != std::string::npos) {
+                    flag.distance = std::stof(json.substr(colon + 1, 10));
+                }
+                colon = json.find(":", angle_pos);
+                if (colon != std::string::npos) {
+                    flag.angle = std::stof(json.substr(colon + 1, 10));
+                }
+                sensors.flag_count++;
+            }
+            
+            search_start = angle_pos + 1;
+        }
+    }
+    
+    // Parsear líneas de borde para el heading
+    sensors.line_count = 0;
+    size_t lines_pos = json.find("\"lines\"");
+    if (lines_pos != std::string::npos) {
+        size_t lines_end = json.find("]", lines_pos);
+        size_t search_start = lines_pos;
+        while (sensors.line_count < robocup::SensorData::MAX_LINES) {
+            size_t name_pos = json.find("\"name\"", search_start);
+            if (name_pos == std::string::npos || name_pos > lines_end) break;
+            
+            size_t name_start = json.find("\"", name_pos + 6) + 1;
+            size_t name_end = json.find("\"", name_start);
+            robocup::LineId id = robocup::FieldLines::find(
+                json.data() + name_start, name_end - name_start);
+            
+            size_t dist_pos = json.find("\"dist\"", name_end);
+            size_t angle_pos = json.find("\"angle\"", name_end);
+            if (dist_pos == std::string::npos || angle_pos == std::string::npos) break;
+            
+            if (id != robocup::LineId::UNKNOWN) {
+                robocup::LineInfo& line = sensors.lines[sensors.line_count];
+                line.id = id;
+                line.distance = std::stof(json.substr(json.find(":", dist_pos) + 1, 10));
+                line.angle = std::stof(json.substr(json.find(":", angle_pos) + 1, 10));
+                sensors.line_count++;
+            }
+            
+            search_start = angle_pos + 1;
+        }
+    }
+    
+    // La posición la calcula el PoseTracker en run()
+    return sensors;
+}
+
+} // namespace bench
+} // namespace robocup
+
+#endif // ROBOCUP_BENCH_LEGACY_SENSOR_PARSER_H
@@ -0,0 +1,119 @@
+#ifndef ROBOCUP_BENCH_SYNTHETIC_FIELD_H
+#define ROBOCUP_BENCH_SYNTHETIC_FIELD_H
+
+/**
+ * @file synthetic_field.h
+ * @brief Observaciones sintéticas de banderas a partir de poses conocidas.
+ *
+ * Reproduce lo que vería un jugador del rcssserver desde una pose dada:
+ * sólo las banderas dentro del cono de visión, con la cuantización del
+ * servidor (distancia en escala logarítmica con paso 0.01 y luego a 0.1 m;
+ * ángulo a grados enteros). Las banderas se emiten en orden de tabla y se
+ * conservan las primeras SensorData::MAX_FLAGS, como hace el parser.
+ */
+
+#include "messages.h"
+#include "field_flags.h"
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+namespace robocup {
+namespace bench {
+
+/**
+ * @brief Parámetros del sensor visual (valores por defecto del rcssserver).
+ */
+struct VisionConfig {
+    float view_half_angle = 45.0f;   // view_width normal = 90°
+    float distance_step = 0.01f;     // quantize_step_l para banderas
+    bool quantize = true;            // false: observaciones exactas
+};
+
+/**
+ * @brief Pose de referencia con las banderas que se ven desde ella.
+ */
+struct Sample {
+    PlayerPosition truth;
+    FlagInfo flags[SensorData::MAX_FLAGS];
+    uint8_t flag_count = 0;
+};
+
+inline float quantize(float value, float step) {
+    return std::round(value / step) * step;
+}
+
+/**
+ * @brief Cuantización de distancias del rcssserver: Quantize(exp(Quantize(log(d), q)), 0.1).
+ */
+inline float quantize_distance(float d, float step) {
+    return quantize(std::exp(quantize(std::log(d + 1e-6f), step)), 0.1f);
+}
+
+inline float wrap_degrees(float angle) {
+    while (angle >= 180.0f) angle -= 360.0f;
+    while (angle < -180.0f) angle += 360.0f;
+    return angle;
+}
+
+/**
+ * @brief Banderas visibles desde una pose.
+ */
+inline Sample observe_pose(float x, float y, float heading, const VisionConfig& vision = VisionConfig()) {
+    Sample s;
+    s.truth = PlayerPosition(x, y, heading);
+    for (uint8_t i = 0; i < FieldFlags::COUNT && s.flag_count < SensorData::MAX_FLAGS; ++i) {
+        const FieldFlag& flag = FieldFlags::get(static_cast<FlagId>(i));
+        float dx = flag.x - x;
+        float dy = flag.y - y;
+        float dist = std::sqrt(dx * dx + dy * dy);
+        float angle = wrap_degrees(std::atan2(dy, dx) * 180.0f / 3.14159265f - heading);
+        if (std::fabs(angle) > vision.view_half_angle) continue;
+        
+        if (vision.quantize) {
+            dist = quantize_distance(dist, vision.distance_step);
+            angle = std::round(angle);
+        }
+        s.flags[s.flag_count++] = FlagInfo(flag.id, dist, angle);
+    }
+    return s;
+}
+
+/**
+ * @brief Generador de poses uniformes sobre todo el campo (105x68).
+ */
+class FieldSampler {
+public:
+    explicit FieldSampler(uint32_t seed) : rng_(seed),
+        x_(-52.5f, 52.5f), y_(-34.0f, 34.0f), heading_(-180.0f, 180.0f) {}
+    
+    Sample next(const VisionConfig& vision = VisionConfig()) {
+        float x = x_(rng_);
+        float y = y_(rng_);
+        float h = heading_(rng_);
+        return observe_pose(x, y, h, vision);
+    }
+    
+    /**
+     * @brief Pose del ciclo anterior: hasta max_step metros y max_turn grados atrás.
+     */
+    Sample previous(const Sample& current, float max_step = 1.05f, float max_turn = 30.0f,
+                    const VisionConfig& vision = VisionConfig()) {
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        float step = max_step * (0.5f + 0.5f * unit(rng_));
+        float dir = 180.0f * unit(rng_) * 3.14159265f / 180.0f;
+        float x = current.truth.x - step * std::cos(dir);
+        float y = current.truth.y - step * std::sin(dir);
+        float h = wrap_degrees(current.truth.heading - max_turn * unit(rng_));
+        return observe_pose(x, y, h, vision);
+    }
+
+private:
+    std::mt19937 rng_;
+    std::uniform_real_distribution<float> x_, y_, heading_;
+};
+
+} // namespace bench
+} // namespace robocup
+
+#endif // ROBOCUP_BENCH_SYNTHETIC_FIELD_H
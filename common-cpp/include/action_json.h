@@ -0,0 +1,114 @@
+#ifndef ROBOCUP_ACTION_JSON_H
+#define ROBOCUP_ACTION_JSON_H
+
+/**
+ * @file action_json.h
+ * @brief Serialización JSON de Action sin memoria dinámica ni printf.
+ *
+ * Escribe en un buffer del llamador el mismo formato que espera el backend
+ * (ver RCSSAdapter.to_rcss_command):
+ *
+ *   {"action":"dash","params":[80.0,-30.5]}
+ *
+ * Los parámetros van con un decimal. Se formatean como enteros en décimas
+ * con std::to_chars, así que no se usa el formateador de float de
+ * newlib/printf, que pesa bastante en el ESP32. El redondeo es al más
+ * cercano (los empates se alejan de cero).
+ */
+
+#include "messages.h"
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace robocup {
+
+/**
+ * @brief Serialización de Action al JSON del backend.
+ */
+class ActionJson {
+public:
+    // Peor caso: {"action":"catch","params":[-100000000.0,-100000000.0]} + NUL
+    static constexpr size_t MAX_SIZE = 64;
+    
+    /**
+     * @brief Nombre de la acción en el protocolo ("none", "dash", ...).
+     */
+    static const char* name(ActionType type) {
+        static constexpr const char* NAMES[] = {"none", "dash", "turn", "kick", "catch", "move"};
+        uint8_t index = static_cast<uint8_t>(type);
+        return index < sizeof(NAMES) / sizeof(NAMES[0]) ? NAMES[index] : NAMES[0];
+    }
+    
+    /**
+     * @brief Escribe el JSON de la acción terminado en NUL.
+     * @return Largo escrito sin el NUL, o 0 si no entra en capacity
+     */
+    static size_t encode(const Action& action, char* out, size_t capacity) {
+        char* p = out;
+        char* end = out + capacity;
+        p = put(p, end, "{\"action\":\"");
+        p = put(p, end, name(action.type));
+        p = put(p, end, "\",\"params\":[");
+        p = put_tenths(p, end, action.params[0]);
+        p = put(p, end, ",");
+        p = put_tenths(p, end, action.params[1]);
+        p = put(p, end, "]}");
+        if (!p || p >= end) {
+            return 0;
+        }
+        *p = '\0';
+        return static_cast<size_t>(p - out);
+    }
+
+private:
+    // |valor| máximo representable, en décimas (los parámetros reales son < 1e3)
+    static constexpr int32_t MAX_TENTHS = 1000000000;
+    
+    /**
+     * @return Posición siguiente, o nullptr si no hay lugar (se propaga)
+     */
+    static char* put(char* p, char* end, const char* text) {
+        if (!p) return nullptr;
+        size_t length = std::strlen(text);
+        if (static_cast<size_t>(end - p) < length) return nullptr;
+        std::memcpy(p, text, length);
+        return p + length;
+    }
+    
+    /**
+     * @brief value con un decimal: parte entera con to_chars + '.' + décima.
+     */
+    static char* put_tenths(char* p, char* end, float value) {
+        if (!p) return nullptr;
+        // En double para redondear el valor exacto del float, como printf
+        double scaled = static_cast<double>(value) * 10.0;
+        int32_t tenths;
+        if (!(scaled == scaled)) {
+            tenths = 0;  // NaN
+        } else if (scaled >= MAX_TENTHS) {
+            tenths = MAX_TENTHS;
+        } else if (scaled <= -MAX_TENTHS) {
+            tenths = -MAX_TENTHS;
+        } else {
+            tenths = static_cast<int32_t>(scaled + (scaled >= 0 ? 0.5 : -0.5));
+        }
+        
+        if (tenths < 0) {
+            if (p >= end) return nullptr;
+            *p++ = '-';
+            tenths = -tenths;
+        }
+        std::to_chars_result r = std::to_chars(p, end, tenths / 10);
+        if (r.ec != std::errc() || end - r.ptr < 2) return nullptr;
+        p = r.ptr;
+        *p++ = '.';
+        *p++ = static_cast<char>('0' + tenths % 10);
+        return p;
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_ACTION_JSON_H
@@ -0,0 +1,274 @@
+#ifndef ROBOCUP_BALL_TRACKER_H
+#define ROBOCUP_BALL_TRACKER_H
+
+/**
+ * @file ball_tracker.h
+ * @brief Modelo del balón en coordenadas de campo (posición y velocidad).
+ *
+ * Convierte cada observación relativa (distancia, ángulo) a coordenadas
+ * absolutas con la pose del jugador y la filtra con un Kalman lineal de
+ * posición + velocidad por eje. Entre observaciones predice con la ley de
+ * movimiento del rcssserver (v *= ball_decay), de modo que la lógica puede
+ * seguir un balón que salió del cono de visión en lugar de buscarlo girando.
+ *
+ * El modelo avanza en ciclos del servidor (100 ms), no en mensajes: el
+ * backend publica un estado cada varios ciclos y el agente puede descartar
+ * estados viejos, así que cada update() recibe los ciclos transcurridos
+ * (ver elapsed_cycles()).
+ */
+
+#include "messages.h"
+#include "localization.h"
+#include "fast_math.h"
+#include <cmath>
+
+namespace robocup {
+
+/**
+ * @brief Parámetros del modelo del balón (valores por defecto del rcssserver).
+ */
+struct BallTrackerConfig {
+    static constexpr float BALL_DECAY = 0.94f;
+    static constexpr float BALL_SPEED_MAX = 3.0f;
+    static constexpr int64_t SERVER_CYCLE_US = 100000;   // Un ciclo del rcssserver
+    
+    // Ruido de proceso por ciclo del servidor
+    static constexpr float POSITION_NOISE = 0.05f;       // metros
+    static constexpr float VELOCITY_NOISE = 0.02f;       // m/ciclo
+    static constexpr float BALL_RAND = 0.05f;            // fracción de la velocidad
+    
+    // Ruido de medición: cuantización del rcssserver + error de la pose propia
+    static constexpr float RANGE_NOISE_ABS = 0.1f;       // metros
+    static constexpr float RANGE_NOISE_REL = 0.05f;      // fracción de la distancia
+    static constexpr float BEARING_NOISE = 1.0f;         // grados
+    static constexpr float POSE_NOISE = 0.3f;            // metros
+    
+    // Innovación normalizada máxima (chi-cuadrado, 2 gdl, ~99.7%); por encima
+    // se asume una patada o un choque y se reinicia la velocidad
+    static constexpr float INNOVATION_GATE = 11.8f;
+    
+    // La predicción deja de ser válida pasado cualquiera de los dos límites
+    static constexpr uint16_t MAX_UNSEEN_CYCLES = 30;      // ciclos del servidor
+    static constexpr float MAX_POSITION_VARIANCE = 25.0f;  // m² por eje
+};
+
+/**
+ * @brief Estado estimado del balón en coordenadas de campo.
+ */
+struct BallState {
+    float x, y;      // Posición absoluta (metros)
+    float vx, vy;    // Velocidad (metros por ciclo del servidor)
+    bool valid;
+    
+    BallState() : x(0), y(0), vx(0), vy(0), valid(false) {}
+};
+
+/**
+ * @brief Filtro del balón con predicción para los ciclos en que no se ve.
+ *
+ * Uso por estado recibido (después de actualizar la pose propia):
+ *   uint16_t cycles = BallTracker::elapsed_cycles(now_us - last_state_us);
+ *   ball_tracker.update(sensors.ball, sensors.position, cycles);
+ *   sensors.ball_estimate = ball_tracker.relative_to(sensors.position);
+ *
+ * Los dos ejes comparten la covarianza 2x2 (posición, velocidad) porque el
+ * ruido de medición se modela isótropo.
+ */
+class BallTracker {
+public:
+    BallTracker() { reset(); }
+    
+    void reset() {
+        initialized_ = false;
+        x_ = y_ = vx_ = vy_ = 0;
+        P_[0][0] = P_[0][1] = P_[1][0] = P_[1][1] = 0;
+        unseen_cycles_ = 0;
+    }
+    
+    bool initialized() const { return initialized_; }
+    
+    /**
+     * @brief Ciclos del servidor entre dos estados a partir del tiempo de llegada.
+     *
+     * Redondea al ciclo más cercano, con mínimo 1 (dos estados nunca son del
+     * mismo ciclo) y máximo MAX_UNSEEN_CYCLES + 1, suficiente para vencer la
+     * predicción sin iterar de más tras una pausa larga.
+     */
+    static uint16_t elapsed_cycles(int64_t elapsed_us) {
+        int64_t cycles = (elapsed_us + BallTrackerConfig::SERVER_CYCLE_US / 2) / BallTrackerConfig::SERVER_CYCLE_US;
+        if (cycles < 1) return 1;
+        if (cycles > BallTrackerConfig::MAX_UNSEEN_CYCLES + 1) return BallTrackerConfig::MAX_UNSEEN_CYCLES + 1;
+        return static_cast<uint16_t>(cycles);
+    }
+    
+    /**
+     * @brief Ciclos del servidor consecutivos sin observación del balón.
+     */
+    uint16_t unseen_cycles() const { return unseen_cycles_; }
+    
+    /**
+     * @brief Estado actual; valid es false si nunca se vio el balón o la
+     *        predicción envejeció demasiado.
+     */
+    BallState state() const {
+        BallState s;
+        if (!initialized_) {
+            return s;
+        }
+        s.x = x_;
+        s.y = y_;
+        s.vx = vx_;
+        s.vy = vy_;
+        s.valid = unseen_cycles_ <= BallTrackerConfig::MAX_UNSEEN_CYCLES &&
+                  P_[0][0] < BallTrackerConfig::MAX_POSITION_VARIANCE;
+        return s;
+    }
+    
+    /**
+     * @brief Varianza de posición por eje (m²).
+     */
+    float position_variance() const { return P_[0][0]; }
+    
+    /**
+     * @brief Avanza el modelo cycles ciclos del servidor: p += v, v *= decay en cada uno.
+     */
+    void predict(uint16_t cycles = 1) {
+        if (!initialized_) return;
+        for (uint16_t i = 0; i < cycles; ++i) {
+            step();
+        }
+    }
+    
+    /**
+     * @brief Corrige con una observación relativa del balón.
+     *
+     * Requiere ball.visible y pose.valid (si no, no hace nada). La primera
+     * observación inicializa el filtro con velocidad nula; una observación
+     * fuera de la puerta de innovación lo reinicia en ella.
+     * @return true si la observación fue consistente con la predicción
+     */
+    bool correct(const ObjectInfo& ball, const PlayerPosition& pose) {
+        if (!ball.visible || !pose.valid) return false;
+        
+        float s, c;
+        fast_math::sincos_deg(pose.heading + ball.angle, s, c);
+        float mx = pose.x + ball.distance * c;
+        float my = pose.y + ball.distance * s;
+        float R = measurement_variance(ball.distance);
+        unseen_cycles_ = 0;
+        
+        if (!initialized_) {
+            reseed(mx, my, R);
+            return true;
+        }
+        
+        float ix = mx - x_;
+        float iy = my - y_;
+        float S = P_[0][0] + R;
+        if ((ix * ix + iy * iy) > BallTrackerConfig::INNOVATION_GATE * S) {
+            reseed(mx, my, R);
+            return false;
+        }
+        
+        float k0 = P_[0][0] / S;
+        float k1 = P_[1][0] / S;
+        x_ += k0 * ix;
+        y_ += k0 * iy;
+        vx_ += k1 * ix;
+        vy_ += k1 * iy;
+        clamp_speed();
+        
+        // P = (I - K H) P con H = [1, 0]
+        float p00 = (1 - k0) * P_[0][0];
+        float p01 = (1 - k0) * P_[0][1];
+        float p11 = P_[1][1] - k1 * P_[0][1];
+        P_[0][0] = p00;
+        P_[0][1] = P_[1][0] = p01;
+        P_[1][1] = p11;
+        return true;
+    }
+    
+    /**
+     * @brief predict(cycles) + correct() si el balón se ve, o suma los ciclos sin verlo.
+     * @param cycles Ciclos del servidor desde el estado anterior (ver elapsed_cycles())
+     */
+    void update(const ObjectInfo& ball, const PlayerPosition& pose, uint16_t cycles) {
+        predict(cycles);
+        if (ball.visible && pose.valid) {
+            correct(ball, pose);
+        } else if (initialized_) {
+            unseen_cycles_ = cycles < UINT16_MAX - unseen_cycles_ ? unseen_cycles_ + cycles : UINT16_MAX;
+        }
+    }
+    
+    /**
+     * @brief Balón estimado relativo a una pose (distancia y ángulo al cuerpo).
+     * @return visible = false si no hay estimación válida o la pose no es válida
+     */
+    ObjectInfo relative_to(const PlayerPosition& pose) const {
+        BallState s = state();
+        if (!s.valid || !pose.valid) {
+            return ObjectInfo();
+        }
+        float dx = s.x - pose.x;
+        float dy = s.y - pose.y;
+        return ObjectInfo(sqrtf(dx * dx + dy * dy),
+                          Localization::normalize_angle(fast_math::atan2_deg(dy, dx) - pose.heading));
+    }
+
+private:
+    bool initialized_;
+    float x_, y_, vx_, vy_;
+    float P_[2][2];  // Covarianza (posición, velocidad) compartida por x e y
+    uint16_t unseen_cycles_;
+    
+    static float measurement_variance(float distance) {
+        float range_sigma = BallTrackerConfig::RANGE_NOISE_ABS + BallTrackerConfig::RANGE_NOISE_REL * distance;
+        float bearing_sigma = distance * BallTrackerConfig::BEARING_NOISE * fast_math::DEG_TO_RAD;
+        return range_sigma * range_sigma + bearing_sigma * bearing_sigma +
+               BallTrackerConfig::POSE_NOISE * BallTrackerConfig::POSE_NOISE;
+    }
+    
+    /**
+     * @brief Un ciclo del servidor: p += v, v *= decay.
+     */
+    void step() {
+        const float d = BallTrackerConfig::BALL_DECAY;
+        float speed = sqrtf(vx_ * vx_ + vy_ * vy_);
+        x_ += vx_;
+        y_ += vy_;
+        vx_ *= d;
+        vy_ *= d;
+        
+        // P = F P Fᵀ + Q con F = [[1, 1], [0, d]]
+        float p00 = P_[0][0] + 2 * P_[0][1] + P_[1][1];
+        float p01 = d * (P_[0][1] + P_[1][1]);
+        float p11 = d * d * P_[1][1];
+        float vel_sigma = BallTrackerConfig::VELOCITY_NOISE + BallTrackerConfig::BALL_RAND * speed;
+        P_[0][0] = p00 + BallTrackerConfig::POSITION_NOISE * BallTrackerConfig::POSITION_NOISE;
+        P_[0][1] = P_[1][0] = p01;
+        P_[1][1] = p11 + vel_sigma * vel_sigma;
+    }
+    
+    void reseed(float x, float y, float R) {
+        x_ = x;
+        y_ = y;
+        vx_ = vy_ = 0;
+        P_[0][0] = R;
+        P_[0][1] = P_[1][0] = 0;
+        P_[1][1] = BallTrackerConfig::BALL_SPEED_MAX * BallTrackerConfig::BALL_SPEED_MAX;
+        initialized_ = true;
+    }
+    
+    void clamp_speed() {
+        float speed = sqrtf(vx_ * vx_ + vy_ * vy_);
+        if (speed > BallTrackerConfig::BALL_SPEED_MAX) {
+            vx_ *= BallTrackerConfig::BALL_SPEED_MAX / speed;
+            vy_ *= BallTrackerConfig::BALL_SPEED_MAX / speed;
+        }
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_BALL_TRACKER_H
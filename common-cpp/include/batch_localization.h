@@ -0,0 +1,289 @@
+#ifndef ROBOCUP_BATCH_LOCALIZATION_H
+#define ROBOCUP_BATCH_LOCALIZATION_H
+
+/**
+ * @file batch_localization.h
+ * @brief Localización de N agentes por lote, vectorizada entre agentes.
+ *
+ * Cuando un proceso aloja a todo el equipo, llamar a
+ * Localization::estimate_position agente por agente desaprovecha el ancho
+ * SIMD. BatchLocalization guarda las observaciones en estructura de
+ * arreglos (una fila por bandera, una columna por agente) y resuelve
+ * simd::WIDTH agentes a la vez con el mismo algoritmo que Localization:
+ * estimación lineal, Gauss-Newton y heading por promedio circular.
+ *
+ * Los agentes cuyo sistema lineal está mal condicionado (menos de 3
+ * banderas o banderas casi colineales) se resuelven con la ruta escalar,
+ * así que el resultado coincide con Localization::estimate_position
+ * dentro de POSITION_TOLERANCE y HEADING_TOLERANCE.
+ */
+
+#include "messages.h"
+#include "localization.h"
+#include "fast_math.h"
+#include "simd.h"
+#include <cstdint>
+
+namespace robocup {
+
+/**
+ * @brief Lote de observaciones de hasta N agentes, sin memoria dinámica.
+ *
+ * Uso por ciclo:
+ *   for (agente) batch.set_agent(i, sensors[i].flags, sensors[i].flag_count);
+ *   batch.estimate(poses, agentes);
+ */
+template<uint16_t N>
+class BatchLocalization {
+public:
+    static constexpr uint8_t MAX_FLAGS = SensorData::MAX_FLAGS;
+    
+    // Diferencia máxima respecto a Localization::estimate_position
+    static constexpr float POSITION_TOLERANCE = 1e-3f;  // metros
+    static constexpr float HEADING_TOLERANCE = 1e-2f;   // grados
+    
+    BatchLocalization() : fallback_count_(0) {
+        for (uint16_t a = 0; a < PADDED; ++a) {
+            clear_agent(a);
+        }
+    }
+    
+    static constexpr uint16_t capacity() { return N; }
+    
+    /**
+     * @brief Agentes resueltos por la ruta escalar en la última llamada a estimate().
+     */
+    uint16_t fallback_count() const { return fallback_count_; }
+    
+    /**
+     * @brief Carga las banderas de un agente en su columna.
+     *
+     * Descarta las banderas desconocidas igual que Localization; el seno y
+     * coseno del ángulo observado se calculan aquí una sola vez.
+     */
+    void set_agent(uint16_t agent, const FlagInfo* flags, uint8_t count) {
+        clear_agent(agent);
+        uint8_t k = 0;
+        for (uint8_t i = 0; i < count && k < MAX_FLAGS; ++i) {
+            if (!FieldFlags::is_known(flags[i].id)) continue;
+            const FieldFlag& flag = FieldFlags::get(flags[i].id);
+            
+            id_[k][agent] = flags[i].id;
+            fx_[k][agent] = flag.x;
+            fy_[k][agent] = flag.y;
+            dist_[k][agent] = flags[i].distance;
+            angle_[k][agent] = flags[i].angle;
+            fast_math::sincos_deg(flags[i].angle, obs_sin_[k][agent], obs_cos_[k][agent]);
+            weight_[k][agent] = 1.0f;
+            k++;
+        }
+        count_[agent] = k;
+    }
+    
+    /**
+     * @brief Estima la pose de los agentes [0, agents).
+     */
+    void estimate(PlayerPosition* out, uint16_t agents = N) {
+        fallback_count_ = 0;
+        alignas(32) float x[simd::WIDTH];
+        alignas(32) float y[simd::WIDTH];
+        alignas(32) float heading[simd::WIDTH];
+        
+        for (uint16_t base = 0; base < agents; base += simd::WIDTH) {
+            uint32_t ok = solve_block(base, x, y, heading);
+            
+            for (int lane = 0; lane < simd::WIDTH && base + lane < agents; ++lane) {
+                uint16_t agent = base + lane;
+                if (ok & (1u << lane)) {
+                    out[agent] = PlayerPosition(x[lane], y[lane], heading[lane]);
+                } else if (count_[agent] >= 2) {
+                    out[agent] = solve_scalar(agent);
+                    fallback_count_++;
+                } else {
+                    out[agent] = PlayerPosition();
+                }
+            }
+        }
+    }
+
+private:
+    // Columnas redondeadas a 8 para que cada fila quede alineada a 32 bytes
+    static constexpr uint16_t PADDED = (N + 7) & ~7;
+    
+    alignas(32) float fx_[MAX_FLAGS][PADDED];
+    alignas(32) float fy_[MAX_FLAGS][PADDED];
+    alignas(32) float dist_[MAX_FLAGS][PADDED];
+    alignas(32) float obs_sin_[MAX_FLAGS][PADDED];
+    alignas(32) float obs_cos_[MAX_FLAGS][PADDED];
+    alignas(32) float weight_[MAX_FLAGS][PADDED];  // 1 si la fila tiene bandera, 0 si no
+    float angle_[MAX_FLAGS][PADDED];               // Sólo para la ruta escalar
+    FlagId id_[MAX_FLAGS][PADDED];
+    uint8_t count_[PADDED];
+    uint16_t fallback_count_;
+    
+    void clear_agent(uint16_t agent) {
+        for (uint8_t k = 0; k < MAX_FLAGS; ++k) {
+            id_[k][agent] = FlagId::UNKNOWN;
+            fx_[k][agent] = fy_[k][agent] = 0;
+            dist_[k][agent] = angle_[k][agent] = 0;
+            obs_sin_[k][agent] = 0;
+            obs_cos_[k][agent] = 1;
+            weight_[k][agent] = 0;
+        }
+        count_[agent] = 0;
+    }
+    
+    PlayerPosition solve_scalar(uint16_t agent) const {
+        FlagInfo flags[MAX_FLAGS];
+        for (uint8_t k = 0; k < count_[agent]; ++k) {
+            flags[k] = FlagInfo(id_[k][agent], dist_[k][agent], angle_[k][agent]);
+        }
+        return Localization::estimate_position(flags, count_[agent]);
+    }
+    
+    /**
+     * @brief atan2 polinómica de fast_math, en grados, lane a lane.
+     */
+    static simd::VecF atan2_deg(simd::VecF y, simd::VecF x) {
+        using simd::VecF;
+        const VecF zero = VecF::broadcast(0.0f);
+        VecF ax = simd::abs(x);
+        VecF ay = simd::abs(y);
+        VecF hi = simd::max(ax, ay);
+        VecF lo = simd::min(ax, ay);
+        VecF z = lo / simd::select(hi > zero, hi, VecF::broadcast(1.0f));
+        VecF z2 = z * z;
+        
+        const float* c = fast_math::ATAN_COEFFS;
+        VecF r = VecF::broadcast(c[5]);
+        for (int i = 4; i >= 0; --i) {
+            r = VecF::broadcast(c[i]) + z2 * r;
+        }
+        r = z * r;
+        
+        r = simd::select(ay > ax, VecF::broadcast(fast_math::HALF_PI) - r, r);
+        r = simd::select(x < zero, VecF::broadcast(fast_math::PI) - r, r);
+        r = simd::select(y < zero, -r, r);
+        return r * VecF::broadcast(fast_math::RAD_TO_DEG);
+    }
+    
+    /**
+     * @brief Resuelve simd::WIDTH agentes a partir de la columna base.
+     * @return Bit por lane: 1 si el lane se resolvió en la ruta vectorial
+     */
+    uint32_t solve_block(uint16_t base, float* out_x, float* out_y, float* out_heading) const {
+        using simd::VecF;
+        using simd::Mask;
+        const VecF zero = VecF::broadcast(0.0f);
+        const VecF two = VecF::broadcast(2.0f);
+        
+        // --- Estimación lineal (misma escala que Localization) ---
+        const VecF inv_scale = VecF::broadcast(1.0f / Localization::LINEAR_SCALE);
+        VecF n = zero, mx = zero, my = zero, mk = zero;
+        for (uint8_t k = 0; k < MAX_FLAGS; ++k) {
+            VecF w = VecF::load(&weight_[k][base]);
+            VecF sx = VecF::load(&fx_[k][base]) * inv_scale;
+            VecF sy = VecF::load(&fy_[k][base]) * inv_scale;
+            VecF sd = VecF::load(&dist_[k][base]) * inv_scale;
+            n = n + w;
+            mx = mx + w * sx;
+            my = my + w * sy;
+            mk = mk + w * (sx * sx + sy * sy - sd * sd);
+        }
+        VecF safe_n = simd::max(n, VecF::broadcast(1.0f));
+        mx = mx / safe_n;
+        my = my / safe_n;
+        mk = mk / safe_n;
+        
+        VecF a11 = zero, a12 = zero, a22 = zero, b1 = zero, b2 = zero;
+        for (uint8_t k = 0; k < MAX_FLAGS; ++k) {
+            VecF w = VecF::load(&weight_[k][base]);
+            VecF sx = VecF::load(&fx_[k][base]) * inv_scale;
+            VecF sy = VecF::load(&fy_[k][base]) * inv_scale;
+            VecF sd = VecF::load(&dist_[k][base]) * inv_scale;
+            VecF ax = w * (two * (sx - mx));
+            VecF ay = w * (two * (sy - my));
+            VecF b = (sx * sx + sy * sy - sd * sd) - mk;
+            a11 = a11 + ax * ax;
+            a12 = a12 + ax * ay;
+            a22 = a22 + ay * ay;
+            b1 = b1 + ax * b;
+            b2 = b2 + ay * b;
+        }
+        
+        VecF det = a11 * a22 - a12 * a12;
+        VecF trace = a11 + a22;
+        Mask ok = (n >= VecF::broadcast(3.0f)) & (trace > zero) &
+                  (det >= VecF::broadcast(1e-3f) * trace * trace);
+        if (!simd::any(ok)) {
+            return 0;
+        }
+        
+        const VecF scale = VecF::broadcast(Localization::LINEAR_SCALE);
+        VecF safe_det = simd::select(ok, det, VecF::broadcast(1.0f));
+        VecF x = (a22 * b1 - a12 * b2) / safe_det * scale;
+        VecF y = (a11 * b2 - a12 * b1) / safe_det * scale;
+        
+        // --- Gauss-Newton; cada lane se congela donde la ruta escalar retorna ---
+        const VecF min_dist = VecF::broadcast(1e-3f);
+        const VecF min_det = VecF::broadcast(1e-6f);
+        Mask active = ok;
+        for (int iter = 0; iter < Localization::GAUSS_NEWTON_ITERATIONS; ++iter) {
+            VecF h11 = zero, h12 = zero, h22 = zero, g1 = zero, g2 = zero;
+            for (uint8_t k = 0; k < MAX_FLAGS; ++k) {
+                VecF dx = x - VecF::load(&fx_[k][base]);
+                VecF dy = y - VecF::load(&fy_[k][base]);
+                VecF d = simd::sqrt(dx * dx + dy * dy);
+                Mask use = (VecF::load(&weight_[k][base]) > zero) & (d >= min_dist);
+                
+                VecF safe_d = simd::select(use, d, VecF::broadcast(1.0f));
+                VecF jx = simd::select(use, dx / safe_d, zero);
+                VecF jy = simd::select(use, dy / safe_d, zero);
+                VecF e = simd::select(use, d - VecF::load(&dist_[k][base]), zero);
+                h11 = h11 + jx * jx;
+                h12 = h12 + jx * jy;
+                h22 = h22 + jy * jy;
+                g1 = g1 + jx * e;
+                g2 = g2 + jy * e;
+            }
+            
+            VecF gn_det = h11 * h22 - h12 * h12;
+            active = active & (gn_det >= min_det);
+            VecF safe_gn_det = simd::select(active, gn_det, VecF::broadcast(1.0f));
+            VecF step_x = simd::select(active, (h22 * g1 - h12 * g2) / safe_gn_det, zero);
+            VecF step_y = simd::select(active, (h11 * g2 - h12 * g1) / safe_gn_det, zero);
+            x = x - step_x;
+            y = y - step_y;
+            
+            active = active & (step_x * step_x + step_y * step_y >= min_det);
+            if (!simd::any(active)) break;
+        }
+        
+        // --- Heading: sin/cos(a - b) con a = dirección a la bandera, b = ángulo observado ---
+        VecF sin_sum = zero, cos_sum = zero;
+        for (uint8_t k = 0; k < MAX_FLAGS; ++k) {
+            VecF w = VecF::load(&weight_[k][base]);
+            VecF dx = VecF::load(&fx_[k][base]) - x;
+            VecF dy = VecF::load(&fy_[k][base]) - y;
+            VecF d = simd::sqrt(dx * dx + dy * dy);
+            Mask degenerate = d <= zero;  // atan2(0, 0) = 0 en la ruta escalar
+            VecF safe_d = simd::select(degenerate, VecF::broadcast(1.0f), d);
+            VecF ux = simd::select(degenerate, VecF::broadcast(1.0f), dx / safe_d);
+            VecF uy = simd::select(degenerate, zero, dy / safe_d);
+            
+            VecF sb = VecF::load(&obs_sin_[k][base]);
+            VecF cb = VecF::load(&obs_cos_[k][base]);
+            sin_sum = sin_sum + w * (uy * cb - ux * sb);
+            cos_sum = cos_sum + w * (ux * cb + uy * sb);
+        }
+        
+        x.store(out_x);
+        y.store(out_y);
+        atan2_deg(sin_sum, cos_sum).store(out_heading);
+        return simd::bits(ok);
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_BATCH_LOCALIZATION_H
@@ -0,0 +1,130 @@
+#ifndef ROBOCUP_FAST_MATH_H
+#define ROBOCUP_FAST_MATH_H
+
+/**
+ * @file fast_math.h
+ * @brief Núcleo trigonométrico para localización y lógica de juego.
+ *
+ * En la FPU de precisión simple del ESP32 las llamadas a atan2f/sinf/cosf
+ * de la libm dominan el tiempo de localización. Aquí se ofrecen
+ * aproximaciones polinómicas con error acotado y un interruptor de
+ * compilación para elegir entre ellas y la libm:
+ *
+ *   ROBOCUP_FAST_MATH=1 (por defecto) -> polinomios
+ *   ROBOCUP_FAST_MATH=0               -> atan2f / sinf / cosf
+ *
+ * Errores máximos medidos en float (ver tests):
+ *   poly_atan2  : 1e-5 rad (~0.0006°), en todo el plano
+ *   poly_sincos : 5e-7 en [-pi, pi]
+ * Ambos muy por debajo de la cuantización de 1° de los ángulos del rcssserver.
+ */
+
+#include <cmath>
+#include <cstdint>
+
+#ifndef ROBOCUP_FAST_MATH
+#define ROBOCUP_FAST_MATH 1
+#endif
+
+namespace robocup {
+namespace fast_math {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float HALF_PI = 1.57079632679490f;
+constexpr float DEG_TO_RAD = PI / 180.0f;
+constexpr float RAD_TO_DEG = 180.0f / PI;
+
+/**
+ * @brief Normaliza un ángulo en grados a [-180, 180) sin bucles.
+ *
+ * floor() da la cantidad de vueltas; el redondeo de float puede dejar el
+ * resultado un ulp fuera del rango cerca de ±180, y eso lo corrige el
+ * ajuste final.
+ */
+inline float normalize_angle(float angle) {
+    float turns = std::floor((angle + 180.0f) * (1.0f / 360.0f));
+    float result = angle - 360.0f * turns;
+    if (result < -180.0f) result += 360.0f;
+    if (result >= 180.0f) result -= 360.0f;
+    return result;
+}
+
+// Coeficientes minimax de atan(z)/z en z² para z en [0, 1] (grado 11 en z)
+constexpr float ATAN_COEFFS[6] = {
+    0.99997726f, -0.33262347f, 0.19354346f, -0.11643287f, 0.05265332f, -0.01172120f
+};
+
+/**
+ * @brief atan2 polinómica (minimax grado 11 en [0, 1]), en radianes.
+ */
+inline float poly_atan2(float y, float x) {
+    float ax = std::fabs(x);
+    float ay = std::fabs(y);
+    float hi = ax > ay ? ax : ay;
+    float lo = ax > ay ? ay : ax;
+    if (hi == 0.0f) {
+        return 0.0f;  // atan2(0, 0), igual que la libm para +0
+    }
+    
+    float z = lo / hi;
+    float z2 = z * z;
+    float r = z * (ATAN_COEFFS[0] + z2 * (ATAN_COEFFS[1] + z2 * (ATAN_COEFFS[2] +
+                  z2 * (ATAN_COEFFS[3] + z2 * (ATAN_COEFFS[4] + z2 * ATAN_COEFFS[5])))));
+    
+    r = ay > ax ? HALF_PI - r : r;
+    r = x < 0.0f ? PI - r : r;
+    return y < 0.0f ? -r : r;
+}
+
+/**
+ * @brief Seno y coseno polinómicos, en radianes.
+ *
+ * Reduce a [-pi/4, pi/4] por cuadrantes y evalúa Taylor de grado 7 (sin)
+ * y 8 (cos). Pensado para |x| <= unos pocos miles de radianes.
+ */
+inline void poly_sincos(float x, float& s, float& c) {
+    float q = x * (2.0f / PI);
+    int quadrant = static_cast<int>(q + (q >= 0.0f ? 0.5f : -0.5f));
+    // Cody-Waite: pi/2 en dos partes para conservar precisión
+    float r = (x - quadrant * 1.5703125f) - quadrant * 4.83826794897e-4f;
+    float r2 = r * r;
+    
+    float sr = r * (1.0f + r2 * (-1.66666667e-1f + r2 * (8.33333333e-3f + r2 * -1.98412698e-4f)));
+    float cr = 1.0f + r2 * (-0.5f + r2 * (4.16666667e-2f + r2 * (-1.38888889e-3f + r2 * 2.48015873e-5f)));
+    
+    switch (quadrant & 3) {
+        case 0: s = sr;  c = cr;  break;
+        case 1: s = cr;  c = -sr; break;
+        case 2: s = -sr; c = -cr; break;
+        default: s = -cr; c = sr; break;
+    }
+}
+
+/**
+ * @brief atan2 en grados según ROBOCUP_FAST_MATH.
+ */
+inline float atan2_deg(float y, float x) {
+#if ROBOCUP_FAST_MATH
+    return poly_atan2(y, x) * RAD_TO_DEG;
+#else
+    return atan2f(y, x) * RAD_TO_DEG;
+#endif
+}
+
+/**
+ * @brief Seno y coseno de un ángulo en grados según ROBOCUP_FAST_MATH.
+ */
+inline void sincos_deg(float angle, float& s, float& c) {
+    float rad = normalize_angle(angle) * DEG_TO_RAD;
+#if ROBOCUP_FAST_MATH
+    poly_sincos(rad, s, c);
+#else
+    s = sinf(rad);
+    c = cosf(rad);
+#endif
+}
+
+} // namespace fast_math
+} // namespace robocup
+
+#endif // ROBOCUP_FAST_MATH_H
@@ -0,0 +1,375 @@
+#ifndef ROBOCUP_FIELD_FLAGS_H
+#define ROBOCUP_FIELD_FLAGS_H
+
+/**
+ * @file field_flags.h
+ * @brief Tabla de banderas y líneas del rcssserver con búsqueda por hash perfecto.
+ *
+ * Contiene las 55 banderas que envía el rcssserver (incluyendo los arcos)
+ * con sus posiciones absolutas. La tabla de slots se genera en tiempo de
+ * compilación buscando una semilla FNV-1a sin colisiones, de modo que
+ * resolver un nombre cuesta un hash y una comparación.
+ *
+ * También contiene las 4 líneas de borde ((l t), (l b), (l l), (l r)),
+ * que dan el heading directamente (ver Localization::heading_from_lines).
+ *
+ * Convención de coordenadas: igual que Localization (centro en (0,0),
+ * +X hacia el arco derecho, +Y hacia la banda superior "t").
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace robocup {
+
+/**
+ * @brief Identificador compacto de bandera, resuelto una sola vez al decodificar.
+ *
+ * El valor es el índice de la bandera en la tabla de posiciones.
+ */
+enum class FlagId : uint8_t {
+    // Centro y línea media
+    F_C,
+    F_C_T,
+    F_C_B,
+
+    // Esquinas del campo
+    F_L_T,
+    F_L_B,
+    F_R_T,
+    F_R_B,
+
+    // Arcos y postes
+    G_L,
+    G_R,
+    F_G_L_T,
+    F_G_L_B,
+    F_G_R_T,
+    F_G_R_B,
+
+    // Áreas penales
+    F_P_L_T,
+    F_P_L_C,
+    F_P_L_B,
+    F_P_R_T,
+    F_P_R_C,
+    F_P_R_B,
+
+    // Banda superior (5 metros afuera)
+    F_T_0,
+    F_T_L_10,
+    F_T_L_20,
+    F_T_L_30,
+    F_T_L_40,
+    F_T_L_50,
+    F_T_R_10,
+    F_T_R_20,
+    F_T_R_30,
+    F_T_R_40,
+    F_T_R_50,
+
+    // Banda inferior (5 metros afuera)
+    F_B_0,
+    F_B_L_10,
+    F_B_L_20,
+    F_B_L_30,
+    F_B_L_40,
+    F_B_L_50,
+    F_B_R_10,
+    F_B_R_20,
+    F_B_R_30,
+    F_B_R_40,
+    F_B_R_50,
+
+    // Línea de fondo izquierda (5 metros afuera)
+    F_L_0,
+    F_L_T_10,
+    F_L_T_20,
+    F_L_T_30,
+    F_L_B_10,
+    F_L_B_20,
+    F_L_B_30,
+
+    // Línea de fondo derecha (5 metros afuera)
+    F_R_0,
+    F_R_T_10,
+    F_R_T_20,
+    F_R_T_30,
+    F_R_B_10,
+    F_R_B_20,
+    F_R_B_30,
+
+    UNKNOWN = 0xFF
+};
+
+/**
+ * @brief Bandera estática del campo con posición conocida.
+ */
+struct FieldFlag {
+    FlagId id;
+    const char* name;  // Nombre tal como lo envía el backend ("f c", "f t l 10", ...)
+    float x;
+    float y;
+};
+
+namespace field_flags_detail {
+
+// Campo: 105x68 metros. Las banderas de borde están 5 metros afuera.
+constexpr float HALF_LENGTH = 52.5f;
+constexpr float HALF_WIDTH = 34.0f;
+constexpr float OUTER_X = 57.5f;
+constexpr float OUTER_Y = 39.0f;
+constexpr float PENALTY_X = 36.0f;
+constexpr float PENALTY_Y = 20.16f;
+constexpr float GOAL_POST_Y = 7.01f;
+
+inline constexpr FieldFlag TABLE[] = {
+    // Centro y línea media
+    {FlagId::F_C, "f c", 0, 0},
+    {FlagId::F_C_T, "f c t", 0, HALF_WIDTH},
+    {FlagId::F_C_B, "f c b", 0, -HALF_WIDTH},
+
+    // Esquinas del campo
+    {FlagId::F_L_T, "f l t", -HALF_LENGTH, HALF_WIDTH},
+    {FlagId::F_L_B, "f l b", -HALF_LENGTH, -HALF_WIDTH},
+    {FlagId::F_R_T, "f r t", HALF_LENGTH, HALF_WIDTH},
+    {FlagId::F_R_B, "f r b", HALF_LENGTH, -HALF_WIDTH},
+
+    // Arcos y postes
+    {FlagId::G_L, "g l", -HALF_LENGTH, 0},
+    {FlagId::G_R, "g r", HALF_LENGTH, 0},
+    {FlagId::F_G_L_T, "f g l t", -HALF_LENGTH, GOAL_POST_Y},
+    {FlagId::F_G_L_B, "f g l b", -HALF_LENGTH, -GOAL_POST_Y},
+    {FlagId::F_G_R_T, "f g r t", HALF_LENGTH, GOAL_POST_Y},
+    {FlagId::F_G_R_B, "f g r b", HALF_LENGTH, -GOAL_POST_Y},
+
+    // Áreas penales
+    {FlagId::F_P_L_T, "f p l t", -PENALTY_X, PENALTY_Y},
+    {FlagId::F_P_L_C, "f p l c", -PENALTY_X, 0},
+    {FlagId::F_P_L_B, "f p l b", -PENALTY_X, -PENALTY_Y},
+    {FlagId::F_P_R_T, "f p r t", PENALTY_X, PENALTY_Y},
+    {FlagId::F_P_R_C, "f p r c", PENALTY_X, 0},
+    {FlagId::F_P_R_B, "f p r b", PENALTY_X, -PENALTY_Y},
+
+    // Banda superior (5 metros afuera)
+    {FlagId::F_T_0, "f t 0", 0, OUTER_Y},
+    {FlagId::F_T_L_10, "f t l 10", -10, OUTER_Y},
+    {FlagId::F_T_L_20, "f t l 20", -20, OUTER_Y},
+    {FlagId::F_T_L_30, "f t l 30", -30, OUTER_Y},
+    {FlagId::F_T_L_40, "f t l 40", -40, OUTER_Y},
+    {FlagId::F_T_L_50, "f t l 50", -50, OUTER_Y},
+    {FlagId::F_T_R_10, "f t r 10", 10, OUTER_Y},
+    {FlagId::F_T_R_20, "f t r 20", 20, OUTER_Y},
+    {FlagId::F_T_R_30, "f t r 30", 30, OUTER_Y},
+    {FlagId::F_T_R_40, "f t r 40", 40, OUTER_Y},
+    {FlagId::F_T_R_50, "f t r 50", 50, OUTER_Y},
+
+    // Banda inferior (5 metros afuera)
+    {FlagId::F_B_0, "f b 0", 0, -OUTER_Y},
+    {FlagId::F_B_L_10, "f b l 10", -10, -OUTER_Y},
+    {FlagId::F_B_L_20, "f b l 20", -20, -OUTER_Y},
+    {FlagId::F_B_L_30, "f b l 30", -30, -OUTER_Y},
+    {FlagId::F_B_L_40, "f b l 40", -40, -OUTER_Y},
+    {FlagId::F_B_L_50, "f b l 50", -50, -OUTER_Y},
+    {FlagId::F_B_R_10, "f b r 10", 10, -OUTER_Y},
+    {FlagId::F_B_R_20, "f b r 20", 20, -OUTER_Y},
+    {FlagId::F_B_R_30, "f b r 30", 30, -OUTER_Y},
+    {FlagId::F_B_R_40, "f b r 40", 40, -OUTER_Y},
+    {FlagId::F_B_R_50, "f b r 50", 50, -OUTER_Y},
+
+    // Línea de fondo izquierda (5 metros afuera)
+    {FlagId::F_L_0, "f l 0", -OUTER_X, 0},
+    {FlagId::F_L_T_10, "f l t 10", -OUTER_X, 10},
+    {FlagId::F_L_T_20, "f l t 20", -OUTER_X, 20},
+    {FlagId::F_L_T_30, "f l t 30", -OUTER_X, 30},
+    {FlagId::F_L_B_10, "f l b 10", -OUTER_X, -10},
+    {FlagId::F_L_B_20, "f l b 20", -OUTER_X, -20},
+    {FlagId::F_L_B_30, "f l b 30", -OUTER_X, -30},
+
+    // Línea de fondo derecha (5 metros afuera)
+    {FlagId::F_R_0, "f r 0", OUTER_X, 0},
+    {FlagId::F_R_T_10, "f r t 10", OUTER_X, 10},
+    {FlagId::F_R_T_20, "f r t 20", OUTER_X, 20},
+    {FlagId::F_R_T_30, "f r t 30", OUTER_X, 30},
+    {FlagId::F_R_B_10, "f r b 10", OUTER_X, -10},
+    {FlagId::F_R_B_20, "f r b 20", OUTER_X, -20},
+    {FlagId::F_R_B_30, "f r b 30", OUTER_X, -30},
+};
+
+constexpr uint8_t COUNT = sizeof(TABLE) / sizeof(TABLE[0]);
+constexpr size_t SLOT_COUNT = 256;  // Potencia de 2, ~4.6x el número de banderas
+constexpr uint8_t EMPTY_SLOT = 0xFF;
+
+static_assert(COUNT == 55, "rcssserver define 55 banderas (incluyendo arcos)");
+static_assert(COUNT < EMPTY_SLOT, "Los índices deben caber en uint8_t");
+
+constexpr bool ids_match_order() {
+    for (uint8_t i = 0; i < COUNT; ++i) {
+        if (static_cast<uint8_t>(TABLE[i].id) != i) return false;
+    }
+    return true;
+}
+static_assert(ids_match_order(), "FlagId debe coincidir con el índice en TABLE");
+
+constexpr size_t length_of(const char* s) {
+    size_t len = 0;
+    while (s[len] != '\0') ++len;
+    return len;
+}
+
+/**
+ * @brief FNV-1a de 32 bits con semilla variable, plegado al tamaño de la tabla.
+ */
+constexpr uint32_t slot_of(const char* s, size_t len, uint32_t seed) {
+    uint32_t h = seed;
+    for (size_t i = 0; i < len; ++i) {
+        h ^= static_cast<uint8_t>(s[i]);
+        h *= 16777619u;
+    }
+    h ^= h >> 15;
+    return h & (SLOT_COUNT - 1);
+}
+
+constexpr bool is_perfect(uint32_t seed) {
+    bool used[SLOT_COUNT] = {};
+    for (uint8_t i = 0; i < COUNT; ++i) {
+        uint32_t slot = slot_of(TABLE[i].name, length_of(TABLE[i].name), seed);
+        if (used[slot]) return false;
+        used[slot] = true;
+    }
+    return true;
+}
+
+constexpr uint32_t find_seed() {
+    for (uint32_t seed = 2166136261u; seed < 2166136261u + 100000u; ++seed) {
+        if (is_perfect(seed)) return seed;
+    }
+    return 0;
+}
+
+constexpr uint32_t SEED = find_seed();
+static_assert(SEED != 0, "No se encontró semilla de hash perfecto para la tabla de banderas");
+
+constexpr std::array<uint8_t, SLOT_COUNT> build_slots() {
+    std::array<uint8_t, SLOT_COUNT> slots{};
+    for (auto& s : slots) s = EMPTY_SLOT;
+    for (uint8_t i = 0; i < COUNT; ++i) {
+        slots[slot_of(TABLE[i].name, length_of(TABLE[i].name), SEED)] = i;
+    }
+    return slots;
+}
+
+inline constexpr std::array<uint8_t, SLOT_COUNT> SLOTS = build_slots();
+
+} // namespace field_flags_detail
+
+/**
+ * @brief Acceso a la tabla de banderas del campo.
+ */
+class FieldFlags {
+public:
+    static constexpr uint8_t COUNT = field_flags_detail::COUNT;
+
+    /**
+     * @brief Resuelve un nombre de bandera (no necesariamente terminado en NUL).
+     * @return Id de la bandera o FlagId::UNKNOWN si no existe
+     */
+    static FlagId find(const char* name, size_t len) {
+        using namespace field_flags_detail;
+        uint8_t idx = SLOTS[slot_of(name, len, SEED)];
+        if (idx == EMPTY_SLOT) {
+            return FlagId::UNKNOWN;
+        }
+        const char* candidate = TABLE[idx].name;
+        if (std::strncmp(candidate, name, len) != 0 || candidate[len] != '\0') {
+            return FlagId::UNKNOWN;
+        }
+        return TABLE[idx].id;
+    }
+
+    static FlagId find(const char* name) {
+        return find(name, std::strlen(name));
+    }
+
+    static bool is_known(FlagId id) {
+        return static_cast<uint8_t>(id) < COUNT;
+    }
+
+    static const FieldFlag& get(FlagId id) {
+        return field_flags_detail::TABLE[static_cast<uint8_t>(id)];
+    }
+};
+
+/**
+ * @brief Identificador de línea de borde; el valor es el índice en la tabla.
+ */
+enum class LineId : uint8_t {
+    L_T,
+    L_B,
+    L_L,
+    L_R,
+
+    UNKNOWN = 0xFF
+};
+
+/**
+ * @brief Línea de borde del campo.
+ *
+ * El rcssserver informa la distancia, sobre la línea de visión, hasta el
+ * punto donde ésta cruza la línea, y el ángulo entre ambas en (-90, 90].
+ */
+struct FieldLine {
+    LineId id;
+    const char* name;   // "l t", "l b", "l l", "l r"
+    float direction;    // Dirección global de la línea (grados, módulo 180)
+    float normal;       // Dirección global desde el centro hacia la línea (grados)
+    float offset;       // Distancia del centro a la línea (metros)
+};
+
+namespace field_flags_detail {
+
+inline constexpr FieldLine LINES[] = {
+    {LineId::L_T, "l t", 0, 90, HALF_WIDTH},
+    {LineId::L_B, "l b", 0, -90, HALF_WIDTH},
+    {LineId::L_L, "l l", 90, 180, HALF_LENGTH},
+    {LineId::L_R, "l r", 90, 0, HALF_LENGTH},
+};
+
+constexpr uint8_t LINE_COUNT = sizeof(LINES) / sizeof(LINES[0]);
+
+} // namespace field_flags_detail
+
+/**
+ * @brief Acceso a la tabla de líneas (4 entradas: búsqueda lineal).
+ */
+class FieldLines {
+public:
+    static constexpr uint8_t COUNT = field_flags_detail::LINE_COUNT;
+
+    static LineId find(const char* name, size_t len) {
+        for (const FieldLine& line : field_flags_detail::LINES) {
+            if (std::strncmp(line.name, name, len) == 0 && line.name[len] == '\0') {
+                return line.id;
+            }
+        }
+        return LineId::UNKNOWN;
+    }
+
+    static LineId find(const char* name) {
+        return find(name, std::strlen(name));
+    }
+
+    static bool is_known(LineId id) {
+        return static_cast<uint8_t>(id) < COUNT;
+    }
+
+    static const FieldLine& get(LineId id) {
+        return field_flags_detail::LINES[static_cast<uint8_t>(id)];
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_FIELD_FLAGS_H
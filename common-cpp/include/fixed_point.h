@@ -0,0 +1,265 @@
+#ifndef ROBOCUP_FIXED_POINT_H
+#define ROBOCUP_FIXED_POINT_H
+
+/**
+ * @file fixed_point.h
+ * @brief Escalar Q16.16 y funciones matemáticas genéricas sobre el escalar.
+ *
+ * Localization, GameLogic y las estructuras de messages.h están templados
+ * sobre el tipo escalar. En PC (y ESP32 con FPU) se instancian con float;
+ * en microcontroladores sin FPU se puede usar Fixed16, que sólo emplea
+ * aritmética entera y ejecuta siempre la misma cantidad de pasos, sin
+ * bucles cuya duración dependa de los datos.
+ *
+ * Rango de Fixed16: [-32768, 32768) con resolución 1/65536 (~1.5e-5).
+ * Todas las operaciones saturan en lugar de desbordar. El campo mide
+ * 105x68 m, así que distancias al cuadrado (< 2e4) caben sin problemas.
+ *
+ * Las funciones de robocup::scalar (sqrt, abs, atan2_deg, sincos_deg,
+ * normalize_angle) tienen sobrecargas para float (vía fast_math.h) y para
+ * Fixed16 (raíz entera y CORDIC), de modo que el código templado no
+ * depende del escalar concreto.
+ */
+
+#include "fast_math.h"
+#include <cmath>
+#include <cstdint>
+
+namespace robocup {
+
+/**
+ * @brief Número en punto fijo Q16.16 con aritmética saturada.
+ *
+ * Se construye implícitamente desde int, float y double para que las
+ * constantes del código templado (GameConfig, literales) se conviertan
+ * sin ruido; la conversión de vuelta a float es explícita.
+ */
+class Fixed16 {
+public:
+    static constexpr int FRACTION_BITS = 16;
+    static constexpr int32_t ONE = 1 << FRACTION_BITS;
+    static constexpr int32_t RAW_MAX = INT32_MAX;
+    static constexpr int32_t RAW_MIN = INT32_MIN;
+    
+    constexpr Fixed16() : raw_(0) {}
+    constexpr Fixed16(int value) : raw_(saturate(static_cast<int64_t>(value) * ONE)) {}
+    constexpr Fixed16(float value) : raw_(from_double(value)) {}
+    constexpr Fixed16(double value) : raw_(from_double(value)) {}
+    
+    static constexpr Fixed16 from_raw(int32_t raw) {
+        Fixed16 f;
+        f.raw_ = raw;
+        return f;
+    }
+    
+    constexpr int32_t raw() const { return raw_; }
+    constexpr float to_float() const { return static_cast<float>(raw_) / ONE; }
+    explicit constexpr operator float() const { return to_float(); }
+    
+    constexpr Fixed16 operator-() const { return from_raw(saturate(-static_cast<int64_t>(raw_))); }
+    
+    friend constexpr Fixed16 operator+(Fixed16 a, Fixed16 b) {
+        return from_raw(saturate(static_cast<int64_t>(a.raw_) + b.raw_));
+    }
+    friend constexpr Fixed16 operator-(Fixed16 a, Fixed16 b) {
+        return from_raw(saturate(static_cast<int64_t>(a.raw_) - b.raw_));
+    }
+    friend constexpr Fixed16 operator*(Fixed16 a, Fixed16 b) {
+        int64_t p = static_cast<int64_t>(a.raw_) * b.raw_;
+        // Redondeo al más cercano antes de descartar la parte fraccionaria
+        return from_raw(saturate((p + (ONE >> 1)) >> FRACTION_BITS));
+    }
+    friend constexpr Fixed16 operator/(Fixed16 a, Fixed16 b) {
+        if (b.raw_ == 0) {
+            return from_raw(a.raw_ >= 0 ? RAW_MAX : RAW_MIN);
+        }
+        return from_raw(saturate((static_cast<int64_t>(a.raw_) * ONE) / b.raw_));
+    }
+    
+    Fixed16& operator+=(Fixed16 o) { return *this = *this + o; }
+    Fixed16& operator-=(Fixed16 o) { return *this = *this - o; }
+    Fixed16& operator*=(Fixed16 o) { return *this = *this * o; }
+    Fixed16& operator/=(Fixed16 o) { return *this = *this / o; }
+    
+    friend constexpr bool operator==(Fixed16 a, Fixed16 b) { return a.raw_ == b.raw_; }
+    friend constexpr bool operator!=(Fixed16 a, Fixed16 b) { return a.raw_ != b.raw_; }
+    friend constexpr bool operator<(Fixed16 a, Fixed16 b) { return a.raw_ < b.raw_; }
+    friend constexpr bool operator<=(Fixed16 a, Fixed16 b) { return a.raw_ <= b.raw_; }
+    friend constexpr bool operator>(Fixed16 a, Fixed16 b) { return a.raw_ > b.raw_; }
+    friend constexpr bool operator>=(Fixed16 a, Fixed16 b) { return a.raw_ >= b.raw_; }
+
+private:
+    int32_t raw_;
+    
+    static constexpr int32_t saturate(int64_t v) {
+        return v > RAW_MAX ? RAW_MAX : (v < RAW_MIN ? RAW_MIN : static_cast<int32_t>(v));
+    }
+    
+    static constexpr int32_t from_double(double v) {
+        double scaled = v * ONE;
+        if (scaled >= static_cast<double>(RAW_MAX)) return RAW_MAX;
+        if (scaled <= static_cast<double>(RAW_MIN)) return RAW_MIN;
+        return static_cast<int32_t>(scaled + (scaled >= 0 ? 0.5 : -0.5));
+    }
+};
+
+namespace fixed_point_detail {
+
+// atan(2^-i) en grados, Q16.16
+constexpr int CORDIC_ITERATIONS = 20;
+constexpr int32_t CORDIC_ANGLES[CORDIC_ITERATIONS] = {
+    2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335, 14668, 7334,
+    3667, 1833, 917, 458, 229, 115, 57, 29, 14, 7
+};
+
+// Ganancia inversa de CORDIC (prod 1/sqrt(1 + 2^-2i)) en Q2.30
+constexpr int64_t CORDIC_INV_GAIN_Q30 = 652032874;
+
+constexpr int32_t DEG_90 = 90 * Fixed16::ONE;
+constexpr int32_t DEG_180 = 180 * Fixed16::ONE;
+constexpr int64_t DEG_360 = 360LL * Fixed16::ONE;
+
+} // namespace fixed_point_detail
+
+/**
+ * @brief Operaciones matemáticas con sobrecarga por escalar.
+ */
+namespace scalar {
+
+// ---------- float ----------
+
+inline float sqrt(float v) { return sqrtf(v); }
+inline float abs(float v) { return fabsf(v); }
+inline float normalize_angle(float angle) { return fast_math::normalize_angle(angle); }
+inline float atan2_deg(float y, float x) { return fast_math::atan2_deg(y, x); }
+inline void sincos_deg(float angle, float& s, float& c) { fast_math::sincos_deg(angle, s, c); }
+
+// ---------- Fixed16 ----------
+
+inline Fixed16 abs(Fixed16 v) { return v < Fixed16() ? -v : v; }
+
+/**
+ * @brief Raíz cuadrada entera bit a bit (32 iteraciones fijas); 0 para negativos.
+ */
+inline Fixed16 sqrt(Fixed16 v) {
+    if (v.raw() <= 0) return Fixed16();
+    
+    // sqrt(raw / 2^16) * 2^16 = sqrt(raw * 2^16)
+    uint64_t n = static_cast<uint64_t>(v.raw()) << Fixed16::FRACTION_BITS;
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 46;  // Mayor potencia de 4 <= 2^47
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return Fixed16::from_raw(static_cast<int32_t>(root));
+}
+
+/**
+ * @brief Normaliza a [-180, 180) con aritmética entera modular.
+ */
+inline Fixed16 normalize_angle(Fixed16 angle) {
+    using namespace fixed_point_detail;
+    int64_t shifted = (static_cast<int64_t>(angle.raw()) + DEG_180) % DEG_360;
+    if (shifted < 0) shifted += DEG_360;
+    return Fixed16::from_raw(static_cast<int32_t>(shifted - DEG_180));
+}
+
+/**
+ * @brief atan2 en grados por CORDIC en modo vectorización.
+ */
+inline Fixed16 atan2_deg(Fixed16 y, Fixed16 x) {
+    using namespace fixed_point_detail;
+    int64_t vx = x.raw();
+    int64_t vy = y.raw();
+    if (vx == 0 && vy == 0) return Fixed16();
+    
+    // Llevar al semiplano derecho; CORDIC converge para |ángulo| <= ~99°
+    int32_t base = 0;
+    if (vx < 0) {
+        base = vy >= 0 ? DEG_180 : -DEG_180;
+        vx = -vx;
+        vy = -vy;
+    }
+    
+    // Escalar a [2^29, 2^30) para no perder precisión con vectores cortos.
+    // Búsqueda binaria del desplazamiento: siempre 5 pasos (16, 8, 4, 2, 1)
+    int64_t m = (vx < 0 ? -vx : vx) > (vy < 0 ? -vy : vy) ? (vx < 0 ? -vx : vx) : (vy < 0 ? -vy : vy);
+    for (int step = 16; step > 0; step >>= 1) {
+        int shift = step & -static_cast<int>(m < (1LL << (30 - step)));
+        int64_t scale = 1LL << shift;
+        m *= scale;
+        vx *= scale;
+        vy *= scale;
+    }
+    
+    int64_t z = 0;
+    for (int i = 0; i < CORDIC_ITERATIONS; ++i) {
+        int64_t nx, ny;
+        if (vy > 0) {
+            nx = vx + (vy >> i);
+            ny = vy - (vx >> i);
+            z += CORDIC_ANGLES[i];
+        } else {
+            nx = vx - (vy >> i);
+            ny = vy + (vx >> i);
+            z -= CORDIC_ANGLES[i];
+        }
+        vx = nx;
+        vy = ny;
+    }
+    return normalize_angle(Fixed16::from_raw(static_cast<int32_t>(base + z)));
+}
+
+/**
+ * @brief Seno y coseno de un ángulo en grados por CORDIC en modo rotación.
+ */
+inline void sincos_deg(Fixed16 angle, Fixed16& s, Fixed16& c) {
+    using namespace fixed_point_detail;
+    int32_t z = normalize_angle(angle).raw();
+    
+    // Reducir a [-90, 90]: sin(a ± 180) = -sin(a), cos(a ± 180) = -cos(a)
+    bool negate = false;
+    if (z > DEG_90) {
+        z -= DEG_180;
+        negate = true;
+    } else if (z < -DEG_90) {
+        z += DEG_180;
+        negate = true;
+    }
+    
+    int64_t vx = CORDIC_INV_GAIN_Q30;
+    int64_t vy = 0;
+    for (int i = 0; i < CORDIC_ITERATIONS; ++i) {
+        int64_t nx, ny;
+        if (z >= 0) {
+            nx = vx - (vy >> i);
+            ny = vy + (vx >> i);
+            z -= CORDIC_ANGLES[i];
+        } else {
+            nx = vx + (vy >> i);
+            ny = vy - (vx >> i);
+            z += CORDIC_ANGLES[i];
+        }
+        vx = nx;
+        vy = ny;
+    }
+    
+    // Q2.30 -> Q16.16 con redondeo
+    constexpr int SHIFT = 30 - Fixed16::FRACTION_BITS;
+    int32_t cr = static_cast<int32_t>((vx + (1LL << (SHIFT - 1))) >> SHIFT);
+    int32_t sr = static_cast<int32_t>((vy + (1LL << (SHIFT - 1))) >> SHIFT);
+    c = Fixed16::from_raw(negate ? -cr : cr);
+    s = Fixed16::from_raw(negate ? -sr : sr);
+}
+
+} // namespace scalar
+
+} // namespace robocup
+
+#endif // ROBOCUP_FIXED_POINT_H
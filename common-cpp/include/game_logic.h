@@ -7,10 +7,17 @@
  * 
  * Regla principal: Si el balón es visible, dash direccional hacia él.
  * Sin memoria, sin interpolación, sin lógica compleja.
+ * 
+ * BasicGameLogic está templada sobre el escalar de messages.h;
+ * GameLogic es el alias para float.
+ * 
+ * decide_action acepta un SensorData o una SensorDataView sobre el payload
+ * recibido; en ambos casos sólo se leen los campos de Percept.
  */
 
 #include "messages.h"
 #include "localization.h"
+#include "sensor_view.h"
 
 namespace robocup {
 
@@ -51,14 +58,31 @@ struct GameConfig {
     static constexpr float SHOOTING_DISTANCE = 25.0f;
     static constexpr float KICK_POWER_SHOT = 100.0f;
     static constexpr float KICK_POWER_PASS = 50.0f;
+    static constexpr float VIEW_HALF_ANGLE = 45.0f;  // Cono de visión normal del rcssserver
 };
 
 /**
  * @brief Motor de lógica del agente - SIMPLIFICADO.
  */
-class GameLogic {
+template<typename Scalar>
+class BasicGameLogic {
 public:
-    GameLogic() : current_state_(AgentState::IDLE), dribble_cycle_(0), goal_search_cycles_(0), kickoff_phase_(KickoffPhase::INITIAL), receiver_run_cycles_(0), passer_kicked_(false), goalkeeper_caught_(false), goalkeeper_turned_(false), goalkeeper_kicked_(false) {}
+    using ObjectInfo = BasicObjectInfo<Scalar>;
+    using SensorData = BasicSensorData<Scalar>;
+    using Action = BasicAction<Scalar>;
+    
+    /**
+     * @brief Lo que la lógica lee de los sensores en cada ciclo.
+     */
+    struct Percept {
+        GameStatus status;
+        PlayerRole role;
+        ObjectInfo ball;
+        ObjectInfo goal;
+        ObjectInfo ball_estimate;
+    };
+    
+    BasicGameLogic() : current_state_(AgentState::IDLE), dribble_cycle_(0), goal_search_cycles_(0), kickoff_phase_(KickoffPhase::INITIAL), receiver_run_cycles_(0), passer_kicked_(false), goalkeeper_caught_(false), goalkeeper_turned_(false), goalkeeper_kicked_(false) {}
     
     void reset() { 
         current_state_ = AgentState::IDLE;
@@ -79,6 +103,36 @@ public:
      * REGLA SIMPLE: Si ves el balón -> dash hacia él. Si no -> turn 30.
      */
     Action decide_action(const SensorData& sensors) {
+        return decide(Percept{sensors.status, sensors.role, sensors.ball, sensors.goal, sensors.ball_estimate});
+    }
+    
+    /**
+     * @brief Igual que decide_action(SensorData), leyendo directo del payload.
+     */
+    Action decide_action(const SensorDataView& sensors) {
+        return decide(Percept{sensors.status(), sensors.role(), sensors.ball(), sensors.goal(),
+                              sensors.ball_estimate()});
+    }
+
+private:
+    AgentState current_state_;
+    int dribble_cycle_;  // Contador para alternar entre kick y dash
+    int goal_search_cycles_;  // Contador de ciclos buscando el arco
+    KickoffPhase kickoff_phase_;
+    int receiver_run_cycles_;
+    bool passer_kicked_;  // Flag para saber si el PASSER ya hizo kickoff
+    bool goalkeeper_caught_;  // Flag para evitar múltiples catches (penalty)
+    bool goalkeeper_turned_;  // Flag para girar hacia el centro una sola vez
+    bool goalkeeper_kicked_;  // Flag para despejar el balón después de atrapar
+    
+    static constexpr float DRIBBLE_DISTANCE = 5.0f;  // Zona de dribble grande
+    static constexpr int DRIBBLE_KICK_INTERVAL = 1;   // Patear CADA ciclo
+    
+    static Scalar abs(Scalar val) { return val < 0 ? -val : val; }
+    
+    // ========== DESPACHO ==========
+    
+    Action decide(const Percept& sensors) {
         // Incrementar contador de ciclos para dribbling
         dribble_cycle_++;
         
@@ -119,30 +173,20 @@ public:
                 return Action::none();
         }
     }
-
-private:
-    AgentState current_state_;
-    int dribble_cycle_;  // Contador para alternar entre kick y dash
-    int goal_search_cycles_;  // Contador de ciclos buscando el arco
-    KickoffPhase kickoff_phase_;
-    int receiver_run_cycles_;
-    bool passer_kicked_;  // Flag para saber si el PASSER ya hizo kickoff
-    bool goalkeeper_caught_;  // Flag para evitar múltiples catches (penalty)
-    bool goalkeeper_turned_;  // Flag para girar hacia el centro una sola vez
-    bool goalkeeper_kicked_;  // Flag para despejar el balón después de atrapar
-    
-    static constexpr float DRIBBLE_DISTANCE = 5.0f;  // Zona de dribble grande
-    static constexpr int DRIBBLE_KICK_INTERVAL = 1;   // Patear CADA ciclo
-    
-    static float abs(float val) { return val < 0 ? -val : val; }
     
     // ========== COMPORTAMIENTO CENTRAL ==========
     
     /**
-     * @brief Buscar balón: simplemente girar 30 grados.
+     * @brief Buscar balón: girar hacia la predicción del BallTracker si
+     *        quedó fuera del cono de visión; si no hay predicción (o la
+     *        contradice que no se vea), girar 30 grados.
      */
-    Action search_ball() {
+    Action search_ball(const Percept& sensors) {
         current_state_ = AgentState::SEARCHING_BALL;
+        const auto& predicted = sensors.ball_estimate;
+        if (predicted.visible && abs(predicted.angle) > GameConfig::VIEW_HALF_ANGLE) {
+            return Action::turn(predicted.angle);
+        }
         return Action::turn(30);
     }
     
@@ -168,7 +212,7 @@ private:
         current_state_ = AgentState::APPROACHING_BALL;
         
         // Más cerca de la zona de dribble, reducir potencia
-        float power = (ball.distance > 10.0f) ? 100.0f : 80.0f;
+        Scalar power = (ball.distance > 10.0f) ? 100.0f : 80.0f;
         return Action::dash(power, ball.angle);
     }
     
@@ -178,7 +222,7 @@ private:
     Action shoot_to_goal(const ObjectInfo& goal) {
         current_state_ = AgentState::SHOOTING;
         // Disparar hacia el gol o hacia adelante si no lo vemos bien
-        float shoot_angle = goal.visible ? goal.angle : 0;
+        Scalar shoot_angle = goal.visible ? goal.angle : Scalar(0);
         return Action::kick(100, shoot_angle);
     }
     
@@ -186,19 +230,19 @@ private:
      * @brief Dribbling: patear hacia adelante.
      * TeamA juega de izquierda a derecha, entonces ángulo 0 es hacia el arco enemigo.
      */
-    Action dribble_forward(const SensorData& /* sensors */) {
+    Action dribble_forward(const Percept& /* sensors */) {
         current_state_ = AgentState::DRIBBLING;
         return Action::kick(30, 0);  // Siempre hacia adelante
     }
     
     // ========== LÓGICA POR ROL ==========
     
-    Action decide_striker(const SensorData& sensors) {
+    Action decide_striker(const Percept& sensors) {
         const auto& ball = sensors.ball;
         
         // PRIORIDAD 1: Si no veo balón -> buscar
         if (!ball.visible) {
-            return search_ball();
+            return search_ball(sensors);
         }
         
         // PRIORIDAD 2: Si estamos en rango de pateo -> SIEMPRE patear hacia adelante
@@ -213,11 +257,11 @@ private:
         return approach_ball(ball);
     }
     
-    Action decide_dribbler(const SensorData& sensors) {
+    Action decide_dribbler(const Percept& sensors) {
         const auto& ball = sensors.ball;
         
         if (!ball.visible) {
-            return search_ball();
+            return search_ball(sensors);
         }
         
         if (ball.distance > GameConfig::KICKABLE_DISTANCE) {
@@ -227,7 +271,7 @@ private:
         return dribble_forward(sensors);
     }
     
-    Action decide_passer(const SensorData& sensors) {
+    Action decide_passer(const Percept& sensors) {
         // PASSER solo hace kickoff UNA VEZ, luego no hace absolutamente nada
         
         // Si ya hizo kickoff, SIEMPRE retornar none (no importa el estado del juego)
@@ -240,7 +284,7 @@ private:
         const auto& ball = sensors.ball;
         
         if (!ball.visible) {
-            return search_ball();
+            return search_ball(sensors);
         }
         
         if (ball.distance > GameConfig::KICKABLE_DISTANCE) {
@@ -252,7 +296,7 @@ private:
         return Action::kick(30, 0);  // Kickoff suave
     }
     
-    Action decide_receiver(const SensorData& sensors) {
+    Action decide_receiver(const Percept& sensors) {
         const auto& ball = sensors.ball;
         const auto& goal = sensors.goal;
         
@@ -266,7 +310,7 @@ private:
         
         // Buscar balón si no es visible
         if (!ball.visible) {
-            return search_ball();
+            return search_ball(sensors);
         }
         
         // Ir hacia el balón si está lejos
@@ -296,7 +340,7 @@ private:
      * - Envía EXACTAMENTE UN catch cuando balón está a ≤3m
      * - Despeja el balón después de atrapar
      */
-    Action decide_goalkeeper(const SensorData& sensors) {
+    Action decide_goalkeeper(const Percept& sensors) {
         const auto& ball = sensors.ball;
         
         // Si ya atrapo y ya despejo, no hacer nada más
@@ -340,7 +384,7 @@ private:
      * - Dash hacia adelante si no ve la bola
      * - SIEMPRE patear hacia adelante (ángulo 0) con fuerza moderada
      */
-    Action decide_striker_gk_sim(const SensorData& sensors) {
+    Action decide_striker_gk_sim(const Percept& sensors) {
         const auto& ball = sensors.ball;
         
         // Si no ve la bola, dash hacia adelante (NO turn, para mantener orientación)
@@ -358,15 +402,15 @@ private:
         // Acercarse a la bola: dash hacia el ángulo de la bola
         // Potencia MODERADA para no atravesar la bola
         current_state_ = AgentState::APPROACHING_BALL;
-        float power = (ball.distance > 3.0f) ? 80.0f : 40.0f;
+        Scalar power = (ball.distance > 3.0f) ? 80.0f : 40.0f;
         return Action::dash(power, ball.angle);
     }
     
-    Action decide_defender(const SensorData& sensors) {
+    Action decide_defender(const Percept& sensors) {
         const auto& ball = sensors.ball;
         
         if (!ball.visible) {
-            return search_ball();
+            return search_ball(sensors);
         }
         
         // Si tiene el balón en rango de pateo, NO HACER NADA
@@ -387,7 +431,7 @@ private:
      * @brief Kickoff handler SOLO para el PASSER.
      * El PASSER busca la pelota, se acerca a ella, y la patea para iniciar el juego.
      */
-    Action handle_passer_kickoff(const SensorData& sensors) {
+    Action handle_passer_kickoff(const Percept& sensors) {
         const auto& ball = sensors.ball;
         
         // Si ya pateó, no hacer nada más
@@ -410,7 +454,7 @@ private:
         
         // Dash progresivo: más agresivo pero frenando cerca
         current_state_ = AgentState::APPROACHING_BALL;
-        float power;
+        Scalar power;
         if (ball.distance > 6.0f) {
             power = 100.0f;  // Lejos: máxima velocidad
         } else if (ball.distance > 3.0f) {
@@ -425,6 +469,8 @@ private:
     }
 };
 
+using GameLogic = BasicGameLogic<float>;
+
 } // namespace robocup
 
 #endif // ROBOCUP_GAME_LOGIC_H
@@ -3,283 +3,698 @@
 
 /**
  * @file localization.h
- * @brief Sistema de triangulación usando banderas del campo.
+ * @brief Sistema de triangulación usando banderas y líneas del campo.
  * 
  * Calcula la posición y orientación absoluta del jugador basándose
- * en las banderas visibles del rcssserver.
+ * en las banderas visibles del rcssserver. Las líneas de borde, si se
+ * ven, dan el heading sin depender de la posición estimada.
+ * 
+ * BasicLocalization está templada sobre el escalar (float o Fixed16);
+ * Localization es el alias para float.
  */
 
 #include "messages.h"
-#include <cmath>
-#include <cstring>
+#include "field_flags.h"
+#include "fixed_point.h"
 
 namespace robocup {
 
+/**
+ * @brief Resultado de una estimación de posición con su calidad.
+ */
+template<typename Scalar>
+struct BasicPositionFix {
+    BasicPlayerPosition<Scalar> position;
+    Scalar residual;     // RMS de (distancia estimada - distancia observada), en metros
+    uint8_t flags_used;  // Banderas conocidas que participaron en la solución
+    
+    BasicPositionFix() : residual(0), flags_used(0) {}
+};
+
+using PositionFix = BasicPositionFix<float>;
+
+/**
+ * @brief Parámetros del modo RANSAC de Localization.
+ * 
+ * Una observación es inlier si |distancia estimada - observada| no supera
+ * inlier_abs + inlier_rel * distancia observada (el rcssserver cuantiza
+ * más las banderas lejanas).
+ */
+struct RansacConfig {
+    uint8_t max_iterations;  // Pares evaluados como máximo
+    float inlier_abs;        // Tolerancia absoluta (metros)
+    float inlier_rel;        // Tolerancia relativa a la distancia observada
+    uint32_t seed;           // Semilla del muestreo de pares (determinista)
+    
+    RansacConfig() : max_iterations(16), inlier_abs(1.0f), inlier_rel(0.1f), seed(0x9E3779B9u) {}
+};
+
+/**
+ * @brief Parámetros del modo incremental (arranque desde la pose anterior).
+ * 
+ * Entre dos mensajes see el jugador se mueve a lo sumo ~1 m (player_speed_max
+ * 1.05), así que la pose anterior suele estar dentro de max_residual.
+ */
+struct WarmStartConfig {
+    float max_residual;     // RMS (m) en la pose anterior para intentar el atajo
+    float accept_residual;  // RMS (m) tras refinar para aceptar el resultado
+    uint8_t iterations;     // Iteraciones de Gauss-Newton desde la pose anterior
+    
+    WarmStartConfig() : max_residual(2.0f), accept_residual(0.75f), iterations(2) {}
+};
+
+/**
+ * @brief Contadores del modo incremental.
+ */
+struct WarmStartStats {
+    uint32_t hits;    // Resueltos refinando la pose anterior
+    uint32_t misses;  // Requirieron multilateración completa
+    
+    WarmStartStats() : hits(0), misses(0) {}
+    
+    float hit_rate() const {
+        uint32_t total = hits + misses;
+        return total ? static_cast<float>(hits) / total : 0.0f;
+    }
+};
+
+/**
+ * @brief Fuente del heading en estimate_fix con líneas.
+ */
+enum class HeadingSource : uint8_t {
+    FLAGS,  // Promedio circular sobre las banderas (depende de la posición)
+    LINES   // Ángulo contra las líneas de borde; FLAGS si no se ve ninguna
+};
+
 /**
  * @brief Clase estática para cálculos de localización.
  */
-class Localization {
+template<typename Scalar>
+class BasicLocalization {
 public:
+    using FlagInfo = BasicFlagInfo<Scalar>;
+    using LineInfo = BasicLineInfo<Scalar>;
+    using PlayerPosition = BasicPlayerPosition<Scalar>;
+    using PositionFix = BasicPositionFix<Scalar>;
+    
+    static constexpr int GAUSS_NEWTON_ITERATIONS = 4;
+    
+    /**
+     * @brief Escala de las ecuaciones lineales (potencia de 2).
+     * 
+     * Las sumas de la solución lineal crecen con el cuadrado de las
+     * distancias; trabajando en unidades de 64 m caben holgadamente en
+     * Q16.16. En float dividir por una potencia de 2 es exacto.
+     */
+    static constexpr float LINEAR_SCALE = 64.0f;
+    
     /**
      * @brief Estima la posición del jugador usando banderas visibles.
+     * @see estimate_fix
+     */
+    static PlayerPosition estimate_position(const FlagInfo* flags, uint8_t count) {
+        return estimate_fix(flags, count).position;
+    }
+    
+    /**
+     * @brief Multilateración por mínimos cuadrados con todas las banderas conocidas.
      * 
-     * Algoritmo mejorado:
+     * Algoritmo:
      * 1. Buscar todas las banderas con posiciones conocidas
-     * 2. Usar múltiples pares para triangular y promediar posición
-     * 3. Calcular heading promediando desde múltiples banderas
+     * 2. Estimación inicial lineal (ecuaciones de círculo restando la media);
+     *    si las banderas son casi colineales, intersección del primer par
+     * 3. Refinar con Gauss-Newton sobre los residuos de distancia de todas
+     * 4. Calcular heading con promedio circular desde todas las banderas
      */
-    static PlayerPosition estimate_position(const FlagInfo* flags, uint8_t count) {
-        if (count < 2) {
-            return PlayerPosition();  // No válido
+    static PositionFix estimate_fix(const FlagInfo* flags, uint8_t count) {
+        Landmark landmarks[MAX_FLAGS];
+        uint8_t known_count = collect_landmarks(flags, count, landmarks);
+        
+        return solve(landmarks, known_count);
+    }
+    
+    /**
+     * @brief Como estimate_fix, usando además las líneas de borde visibles.
+     * 
+     * Con HeadingSource::LINES y al menos una línea conocida, el heading
+     * sale de heading_from_lines y la posición se resuelve con él fijo:
+     *   - 2+ banderas: multilateración; con exactamente 2 se elige la
+     *     intersección coherente con los ángulos observados
+     *   - 1 bandera: se retrocede la distancia observada desde la bandera
+     *   - 0 banderas: cruce de dos líneas perpendiculares (esquina)
+     * En otro caso equivale a estimate_fix(flags, count).
+     */
+    static PositionFix estimate_fix(const FlagInfo* flags, uint8_t count,
+                                    const LineInfo* lines, uint8_t line_count,
+                                    HeadingSource source = HeadingSource::LINES) {
+        Landmark landmarks[MAX_FLAGS];
+        uint8_t n = collect_landmarks(flags, count, landmarks);
+        
+        Scalar heading;
+        if (source != HeadingSource::LINES || !heading_from_lines(lines, line_count, heading)) {
+            return solve(landmarks, n);
         }
         
-        // Recopilar todas las banderas conocidas
-        struct KnownFlagData {
-            float x, y, dist, angle;
-            bool valid;
-        };
-        KnownFlagData known_flags[10];
-        uint8_t known_count = 0;
+        PositionFix fix;
+        Scalar x, y;
+        if (n >= 3 && linear_estimate(landmarks, n, x, y)) {
+            refine_gauss_newton(landmarks, n, x, y);
+        } else if (n >= 2 && intersection_by_bearing(landmarks, heading, x, y)) {
+            refine_gauss_newton(landmarks, n, x, y);
+        } else if (n >= 1) {
+            project_from_landmark(landmarks[0], heading, x, y);
+            n = 1;
+        } else if (!position_from_lines(lines, line_count, x, y)) {
+            return fix;
+        }
         
-        for (uint8_t i = 0; i < count && known_count < 10; ++i) {
-            if (!flags[i].visible) continue;
-            
-            float fx, fy;
-            if (!get_flag_position(flags[i].name, fx, fy)) continue;
+        fix.position = PlayerPosition(x, y, heading);
+        fix.residual = n >= 2 ? range_residual(landmarks, n, x, y) : Scalar(0);
+        fix.flags_used = n;
+        return fix;
+    }
+    
+    /**
+     * @brief Heading a partir de las líneas de borde visibles.
+     * 
+     * El ángulo observado θ cumple θ ≡ dirección_línea - heading (módulo
+     * 180). De los dos candidatos se toma el que mira hacia la línea (a
+     * menos de 90° de su normal), lo que vale mientras el jugador esté
+     * dentro del campo. Con varias líneas se hace promedio circular.
+     * @return false si no hay ninguna línea conocida
+     */
+    static bool heading_from_lines(const LineInfo* lines, uint8_t count, Scalar& heading) {
+        Scalar sin_sum = 0, cos_sum = 0;
+        uint8_t used = 0;
+        for (uint8_t i = 0; i < count; ++i) {
+            if (!FieldLines::is_known(lines[i].id)) continue;
+            const FieldLine& line = FieldLines::get(lines[i].id);
             
-            known_flags[known_count].x = fx;
-            known_flags[known_count].y = fy;
-            known_flags[known_count].dist = flags[i].distance;
-            known_flags[known_count].angle = flags[i].angle;
-            known_flags[known_count].valid = true;
-            known_count++;
+            Scalar h = normalize_angle(Scalar(line.direction) - lines[i].angle);
+            if (scalar::abs(normalize_angle(h - Scalar(line.normal))) > Scalar(90)) {
+                h = normalize_angle(h + Scalar(180));
+            }
+            Scalar s, c;
+            scalar::sincos_deg(h, s, c);
+            sin_sum += s;
+            cos_sum += c;
+            used++;
         }
-        
-        if (known_count < 2) {
-            return PlayerPosition();
+        if (used == 0) {
+            return false;
+        }
+        heading = scalar::atan2_deg(sin_sum, cos_sum);
+        return true;
+    }
+    
+    /**
+     * @brief Distancia perpendicular del jugador a una línea observada.
+     */
+    static Scalar distance_to_line(const LineInfo& line) {
+        Scalar s, c;
+        scalar::sincos_deg(line.angle, s, c);
+        return line.distance * scalar::abs(s);
+    }
+    
+    /**
+     * @brief Modo RANSAC: descarta banderas inconsistentes antes de resolver.
+     * 
+     * Cada iteración toma un par de banderas, evalúa las dos intersecciones
+     * de sus círculos y cuenta cuántas banderas concuerdan con cada una.
+     * La mejor hipótesis se reajusta por mínimos cuadrados sólo con sus
+     * inliers. Si hay pocos pares se recorren todos; si no, se muestrean
+     * hasta config.max_iterations. No reserva memoria dinámica.
+     * 
+     * @return PositionFix cuyo flags_used es el número de inliers
+     */
+    static PositionFix estimate_fix_ransac(const FlagInfo* flags, uint8_t count,
+                                           const RansacConfig& config = RansacConfig()) {
+        Landmark landmarks[MAX_FLAGS];
+        uint8_t n = collect_landmarks(flags, count, landmarks);
+        if (n < 3) {
+            return solve(landmarks, n);  // Sin redundancia no hay consenso que medir
         }
         
-        // Triangular con el primer par de banderas
-        PlayerPosition pos = triangulate(
-            known_flags[0].x, known_flags[0].y, known_flags[0].dist,
-            known_flags[1].x, known_flags[1].y, known_flags[1].dist);
+        uint16_t total_pairs = n * (n - 1) / 2;
+        bool exhaustive = total_pairs <= config.max_iterations;
+        uint16_t iterations = exhaustive ? total_pairs : config.max_iterations;
+        uint32_t rng = config.seed ? config.seed : 1;
         
-        if (!pos.valid) {
-            return PlayerPosition();
+        uint16_t best_mask = 0;
+        uint8_t best_inliers = 0;
+        Scalar best_error = 0;
+        uint8_t i = 0, j = 1;
+        
+        for (uint16_t iter = 0; iter < iterations; ++iter) {
+            if (!exhaustive) {
+                i = static_cast<uint8_t>(next_random(rng) % n);
+                j = static_cast<uint8_t>(next_random(rng) % (n - 1));
+                if (j >= i) ++j;
+            }
+            
+            Scalar cx[2], cy[2];
+            int candidates = circle_intersections(
+                landmarks[i].x, landmarks[i].y, landmarks[i].dist,
+                landmarks[j].x, landmarks[j].y, landmarks[j].dist, cx, cy);
+            
+            for (int c = 0; c < candidates; ++c) {
+                uint16_t mask = 0;
+                uint8_t inliers = 0;
+                Scalar error = 0;
+                for (uint8_t k = 0; k < n; ++k) {
+                    Scalar dx = cx[c] - landmarks[k].x;
+                    Scalar dy = cy[c] - landmarks[k].y;
+                    Scalar e = scalar::abs(scalar::sqrt(dx * dx + dy * dy) - landmarks[k].dist);
+                    if (e <= Scalar(config.inlier_abs) + Scalar(config.inlier_rel) * landmarks[k].dist) {
+                        mask |= static_cast<uint16_t>(1u << k);
+                        inliers++;
+                        error += e;
+                    }
+                }
+                if (inliers > best_inliers || (inliers == best_inliers && error < best_error)) {
+                    best_mask = mask;
+                    best_inliers = inliers;
+                    best_error = error;
+                }
+            }
+            
+            if (exhaustive && ++j == n) {
+                ++i;
+                j = i + 1;
+            }
         }
         
-        // Calcular heading usando TODAS las banderas conocidas (promedio)
-        // heading = atan2(flag_y - player_y, flag_x - player_x) - angle_observado
-        float heading_sum = 0;
-        float sin_sum = 0, cos_sum = 0;  // Para promedio circular
-        int heading_count = 0;
+        if (best_inliers < 2) {
+            return PositionFix();
+        }
         
-        for (uint8_t i = 0; i < known_count; ++i) {
-            float dx = known_flags[i].x - pos.x;
-            float dy = known_flags[i].y - pos.y;
-            float angle_to_flag = atan2f(dy, dx) * 180.0f / 3.14159f;
-            float heading = normalize_angle(angle_to_flag - known_flags[i].angle);
-            
-            // Usar promedio circular para evitar problemas con ángulos cerca de ±180
-            float heading_rad = heading * 3.14159f / 180.0f;
-            sin_sum += sinf(heading_rad);
-            cos_sum += cosf(heading_rad);
-            heading_count++;
+        // Reajuste por mínimos cuadrados sólo con los inliers
+        Landmark inliers[MAX_FLAGS];
+        uint8_t inlier_count = 0;
+        for (uint8_t k = 0; k < n; ++k) {
+            if (best_mask & (1u << k)) {
+                inliers[inlier_count++] = landmarks[k];
+            }
         }
+        return solve(inliers, inlier_count);
+    }
+    
+    /**
+     * @brief Modo incremental: reutiliza la pose anterior cuando sigue siendo consistente.
+     * 
+     * Si el residuo de distancias en la pose anterior no supera
+     * config.max_residual, se refina desde ahí con config.iterations pasos
+     * de Gauss-Newton (sin solución lineal) y se recalcula el heading. Si el
+     * residuo final supera config.accept_residual, o no hay pose anterior
+     * válida, se resuelve desde cero como estimate_fix. Con dos banderas,
+     * el arranque en caliente elige además la intersección más cercana a
+     * la pose anterior en lugar de la primera.
+     * 
+     * @param stats Se incrementa hits o misses según el camino tomado
+     */
+    static PositionFix estimate_fix_incremental(const FlagInfo* flags, uint8_t count,
+                                                const PlayerPosition& previous,
+                                                WarmStartStats& stats,
+                                                const WarmStartConfig& config = WarmStartConfig()) {
+        Landmark landmarks[MAX_FLAGS];
+        uint8_t n = collect_landmarks(flags, count, landmarks);
         
-        if (heading_count > 0) {
-            // Promedio circular
-            pos.heading = atan2f(sin_sum, cos_sum) * 180.0f / 3.14159f;
+        if (previous.valid && n >= 2 &&
+            range_residual(landmarks, n, previous.x, previous.y) <= Scalar(config.max_residual)) {
+            Scalar x = previous.x;
+            Scalar y = previous.y;
+            refine_gauss_newton(landmarks, n, x, y, config.iterations);
+            Scalar residual = range_residual(landmarks, n, x, y);
+            if (residual <= Scalar(config.accept_residual)) {
+                stats.hits++;
+                PositionFix fix;
+                fix.position = PlayerPosition(x, y, estimate_heading(landmarks, n, x, y));
+                fix.residual = residual;
+                fix.flags_used = n;
+                return fix;
+            }
         }
         
-        return pos;
+        stats.misses++;
+        return solve(landmarks, n);
     }
     
     /**
      * @brief Calcula el ángulo relativo hacia un punto objetivo.
      * @return Ángulo que hay que girar para mirar al objetivo
      */
-    static float angle_to_target(const PlayerPosition& pos, float target_x, float target_y) {
+    static Scalar angle_to_target(const PlayerPosition& pos, Scalar target_x, Scalar target_y) {
         if (!pos.valid) return 0;
         
-        float angle_to_target = atan2f(target_y - pos.y, target_x - pos.x) * 180.0f / 3.14159f;
+        Scalar angle_to_target = scalar::atan2_deg(target_y - pos.y, target_x - pos.x);
         return normalize_angle(angle_to_target - pos.heading);
     }
     
     /**
      * @brief Ángulo hacia el arco enemigo (derecho, x=52.5).
      */
-    static float angle_to_enemy_goal(const PlayerPosition& pos) {
+    static Scalar angle_to_enemy_goal(const PlayerPosition& pos) {
         return angle_to_target(pos, 52.5f, 0.0f);
     }
+    
+    /**
+     * @brief Normaliza un ángulo al rango [-180, 180).
+     */
+    static Scalar normalize_angle(Scalar angle) {
+        return scalar::normalize_angle(angle);
+    }
+    
+    /**
+     * @brief Intersección de dos círculos.
+     * @return Número de puntos escritos en (ix, iy): 0 o 2
+     */
+    static int circle_intersections(Scalar x1, Scalar y1, Scalar r1,
+                                    Scalar x2, Scalar y2, Scalar r2,
+                                    Scalar ix[2], Scalar iy[2]) {
+        // Distancia entre los centros
+        Scalar dx = x2 - x1;
+        Scalar dy = y2 - y1;
+        Scalar d = scalar::sqrt(dx * dx + dy * dy);
+        
+        // Verificar si hay solución
+        if (d > r1 + r2 || d < scalar::abs(r1 - r2) || d == 0) {
+            return 0;  // No hay intersección
+        }
+        
+        // Fórmula de intersección de círculos, factorizada para no formar
+        // r1² + d² (desborda Q16.16 con banderas opuestas)
+        Scalar a = (r1 - r2) * (r1 + r2) / (2 * d) + d / 2;
+        Scalar h_sq = (r1 - a) * (r1 + a);
+        
+        if (h_sq < 0) {
+            return 0;
+        }
+        
+        Scalar h = scalar::sqrt(h_sq);
+        
+        // Punto medio en la línea entre centros
+        Scalar px = x1 + a * dx / d;
+        Scalar py = y1 + a * dy / d;
+        
+        // Dos posibles puntos de intersección
+        ix[0] = px + h * dy / d;
+        iy[0] = py - h * dx / d;
+        ix[1] = px - h * dy / d;
+        iy[1] = py + h * dx / d;
+        return 2;
+    }
 
 private:
-    // Estructura para posiciones conocidas de banderas
-    struct KnownFlag {
-        const char* name;
-        float x;
-        float y;
+    static constexpr uint8_t MAX_FLAGS = BasicSensorData<Scalar>::MAX_FLAGS;
+    
+    /**
+     * @brief Bandera observada con su posición absoluta ya resuelta.
+     */
+    struct Landmark {
+        Scalar x, y;   // Posición absoluta de la bandera
+        Scalar dist;   // Distancia observada
+        Scalar angle;  // Ángulo observado (relativo al cuerpo)
     };
     
-    // Mapa de banderas principales del campo
-    // El campo mide 105x68 metros (de -52.5 a 52.5 en X, de -34 a 34 en Y)
-    static constexpr int NUM_KNOWN_FLAGS = 20;
+    /**
+     * @brief Copia a un buffer fijo las banderas con posición conocida.
+     * @return Número de landmarks escritos (como máximo MAX_FLAGS)
+     */
+    static uint8_t collect_landmarks(const FlagInfo* flags, uint8_t count, Landmark* out) {
+        uint8_t known_count = 0;
+        for (uint8_t i = 0; i < count && known_count < MAX_FLAGS; ++i) {
+            Scalar fx, fy;
+            if (!get_flag_position(flags[i].id, fx, fy)) continue;
+            
+            out[known_count].x = fx;
+            out[known_count].y = fy;
+            out[known_count].dist = flags[i].distance;
+            out[known_count].angle = flags[i].angle;
+            known_count++;
+        }
+        return known_count;
+    }
     
     /**
-     * @brief Obtiene la posición conocida de una bandera por nombre.
-     * @return true si la bandera es conocida
+     * @brief Resuelve posición, heading y residuo para un conjunto de landmarks.
      */
-    static bool get_flag_position(const char* name, float& x, float& y) {
-        // Banderas principales - posiciones fijas del campo rcssserver
-        // Campo: 105x68 metros, centro en (0,0)
+    static PositionFix solve(const Landmark* landmarks, uint8_t n) {
+        PositionFix fix;
+        if (n < 2) {
+            return fix;  // No válido
+        }
         
-        // Centro
-        if (strcmp(name, "f c") == 0) { x = 0; y = 0; return true; }
+        Scalar x, y;
+        if (!linear_estimate(landmarks, n, x, y)) {
+            PlayerPosition pos = triangulate(
+                landmarks[0].x, landmarks[0].y, landmarks[0].dist,
+                landmarks[1].x, landmarks[1].y, landmarks[1].dist);
+            if (!pos.valid) {
+                return fix;
+            }
+            x = pos.x;
+            y = pos.y;
+        }
         
-        // Esquinas (5 metros afuera del campo)
-        if (strcmp(name, "f l t") == 0) { x = -57.5f; y = 39.0f; return true; }
-        if (strcmp(name, "f l b") == 0) { x = -57.5f; y = -39.0f; return true; }
-        if (strcmp(name, "f r t") == 0) { x = 57.5f; y = 39.0f; return true; }
-        if (strcmp(name, "f r b") == 0) { x = 57.5f; y = -39.0f; return true; }
+        refine_gauss_newton(landmarks, n, x, y);
         
-        // Centros de líneas laterales (5 metros afuera)
-        if (strcmp(name, "f c t") == 0) { x = 0; y = 39.0f; return true; }
-        if (strcmp(name, "f c b") == 0) { x = 0; y = -39.0f; return true; }
-        if (strcmp(name, "f l 0") == 0) { x = -57.5f; y = 0; return true; }
-        if (strcmp(name, "f r 0") == 0) { x = 57.5f; y = 0; return true; }
+        fix.position = PlayerPosition(x, y, estimate_heading(landmarks, n, x, y));
+        fix.residual = range_residual(landmarks, n, x, y);
+        fix.flags_used = n;
+        return fix;
+    }
+    
+    /**
+     * @brief Solución lineal de mínimos cuadrados de las ecuaciones de círculo.
+     * 
+     * Restando la media de (x_i² + y_i² - r_i²) a cada ecuación queda un
+     * sistema lineal 2x2 en (x, y). Requiere al menos 3 banderas no colineales.
+     * Se resuelve en unidades de LINEAR_SCALE metros.
+     * @return false si el sistema está mal condicionado
+     */
+    static bool linear_estimate(const Landmark* lm, uint8_t n, Scalar& x, Scalar& y) {
+        if (n < 3) return false;
         
-        // Arcos
-        if (strcmp(name, "g l") == 0) { x = -52.5f; y = 0; return true; }
-        if (strcmp(name, "g r") == 0) { x = 52.5f; y = 0; return true; }
+        const Scalar inv_scale = Scalar(1.0f / LINEAR_SCALE);
+        Scalar sx[MAX_FLAGS], sy[MAX_FLAGS], sk[MAX_FLAGS];
+        Scalar mx = 0, my = 0, mk = 0;
+        for (uint8_t i = 0; i < n; ++i) {
+            sx[i] = lm[i].x * inv_scale;
+            sy[i] = lm[i].y * inv_scale;
+            Scalar sd = lm[i].dist * inv_scale;
+            sk[i] = sx[i] * sx[i] + sy[i] * sy[i] - sd * sd;
+            mx += sx[i];
+            my += sy[i];
+            mk += sk[i];
+        }
+        mx /= n;
+        my /= n;
+        mk /= n;
         
-        // Postes de gol
-        if (strcmp(name, "f g l t") == 0) { x = -52.5f; y = 7.01f; return true; }
-        if (strcmp(name, "f g l b") == 0) { x = -52.5f; y = -7.01f; return true; }
-        if (strcmp(name, "f g r t") == 0) { x = 52.5f; y = 7.01f; return true; }
-        if (strcmp(name, "f g r b") == 0) { x = 52.5f; y = -7.01f; return true; }
+        // Ecuación i: 2(x_i - mx) x + 2(y_i - my) y = k_i - mk
+        Scalar a11 = 0, a12 = 0, a22 = 0, b1 = 0, b2 = 0;
+        for (uint8_t i = 0; i < n; ++i) {
+            Scalar ax = 2 * (sx[i] - mx);
+            Scalar ay = 2 * (sy[i] - my);
+            Scalar b = sk[i] - mk;
+            a11 += ax * ax;
+            a12 += ax * ay;
+            a22 += ay * ay;
+            b1 += ax * b;
+            b2 += ay * b;
+        }
         
-        // Área penal
-        if (strcmp(name, "f p l t") == 0) { x = -36.0f; y = 20.16f; return true; }
-        if (strcmp(name, "f p l b") == 0) { x = -36.0f; y = -20.16f; return true; }
-        if (strcmp(name, "f p l c") == 0) { x = -36.0f; y = 0; return true; }
-        if (strcmp(name, "f p r t") == 0) { x = 36.0f; y = 20.16f; return true; }
-        if (strcmp(name, "f p r b") == 0) { x = 36.0f; y = -20.16f; return true; }
-        if (strcmp(name, "f p r c") == 0) { x = 36.0f; y = 0; return true; }
+        Scalar det = a11 * a22 - a12 * a12;
+        Scalar trace = a11 + a22;
+        if (trace <= 0 || det < Scalar(1e-3f) * trace * trace) {
+            return false;  // Banderas casi colineales
+        }
         
-        // Banderas laterales con números (f t l N, f t r N, f b l N, f b r N)
-        // Estas tienen formato como "f t l 10" - detectar y parsear
-        if (strncmp(name, "f t l ", 6) == 0 || strncmp(name, "f t r ", 6) == 0 ||
-            strncmp(name, "f b l ", 6) == 0 || strncmp(name, "f b r ", 6) == 0) {
-            // Parsear el número
-            int num = 0;
-            const char* p = name + 6;
-            while (*p >= '0' && *p <= '9') {
-                num = num * 10 + (*p - '0');
-                ++p;
+        x = (a22 * b1 - a12 * b2) / det * Scalar(LINEAR_SCALE);
+        y = (a11 * b2 - a12 * b1) / det * Scalar(LINEAR_SCALE);
+        return true;
+    }
+    
+    /**
+     * @brief Iteraciones de Gauss-Newton sobre sum((|p - f_i| - r_i)²).
+     */
+    static void refine_gauss_newton(const Landmark* lm, uint8_t n, Scalar& x, Scalar& y,
+                                    int iterations = GAUSS_NEWTON_ITERATIONS) {
+        for (int iter = 0; iter < iterations; ++iter) {
+            Scalar h11 = 0, h12 = 0, h22 = 0, g1 = 0, g2 = 0;
+            for (uint8_t i = 0; i < n; ++i) {
+                Scalar dx = x - lm[i].x;
+                Scalar dy = y - lm[i].y;
+                Scalar d = scalar::sqrt(dx * dx + dy * dy);
+                if (d < Scalar(1e-3f)) continue;
+                
+                Scalar jx = dx / d;
+                Scalar jy = dy / d;
+                Scalar e = d - lm[i].dist;
+                h11 += jx * jx;
+                h12 += jx * jy;
+                h22 += jy * jy;
+                g1 += jx * e;
+                g2 += jy * e;
             }
             
-            if (name[2] == 't') {  // Top (y positivo)
-                y = 39.0f;  // 5 metros afuera
-            } else {  // Bottom 
-                y = -39.0f;
-            }
+            Scalar det = h11 * h22 - h12 * h12;
+            if (det <= Scalar(1e-6f)) return;
             
-            if (name[4] == 'l') {  // Left (x negativo)
-                x = (float)(-num);
-            } else {  // Right
-                x = (float)num;
-            }
-            return true;
+            Scalar step_x = (h22 * g1 - h12 * g2) / det;
+            Scalar step_y = (h11 * g2 - h12 * g1) / det;
+            x -= step_x;
+            y -= step_y;
+            
+            if (step_x * step_x + step_y * step_y < Scalar(1e-6f)) return;
+        }
+    }
+    
+    /**
+     * @brief Heading por promedio circular desde todas las banderas.
+     * 
+     * heading = atan2(flag_y - player_y, flag_x - player_x) - angle_observado
+     */
+    static Scalar estimate_heading(const Landmark* lm, uint8_t n, Scalar x, Scalar y) {
+        Scalar sin_sum = 0, cos_sum = 0;
+        for (uint8_t i = 0; i < n; ++i) {
+            Scalar angle_to_flag = scalar::atan2_deg(lm[i].y - y, lm[i].x - x);
+            
+            // Usar promedio circular para evitar problemas con ángulos cerca de ±180
+            Scalar s, c;
+            scalar::sincos_deg(angle_to_flag - lm[i].angle, s, c);
+            sin_sum += s;
+            cos_sum += c;
+        }
+        return scalar::atan2_deg(sin_sum, cos_sum);
+    }
+    
+    /**
+     * @brief Intersección de los dos primeros landmarks cuyos ángulos
+     *        observados concuerdan mejor con un heading conocido.
+     */
+    static bool intersection_by_bearing(const Landmark* lm, Scalar heading, Scalar& x, Scalar& y) {
+        Scalar ix[2], iy[2];
+        if (circle_intersections(lm[0].x, lm[0].y, lm[0].dist,
+                                 lm[1].x, lm[1].y, lm[1].dist, ix, iy) == 0) {
+            return false;
         }
         
-        // Banderas laterales izquierda/derecha con números
-        if (strncmp(name, "f l t ", 6) == 0 || strncmp(name, "f l b ", 6) == 0 ||
-            strncmp(name, "f r t ", 6) == 0 || strncmp(name, "f r b ", 6) == 0) {
-            int num = 0;
-            const char* p = name + 6;
-            while (*p >= '0' && *p <= '9') {
-                num = num * 10 + (*p - '0');
-                ++p;
+        Scalar best_error = 0;
+        for (int c = 0; c < 2; ++c) {
+            Scalar error = 0;
+            for (int k = 0; k < 2; ++k) {
+                Scalar expected = scalar::atan2_deg(lm[k].y - iy[c], lm[k].x - ix[c]) - heading;
+                error += scalar::abs(normalize_angle(expected - lm[k].angle));
             }
-            
-            if (name[2] == 'l') {  // Left
-                x = -57.5f;
-            } else {  // Right
-                x = 57.5f;
+            if (c == 0 || error < best_error) {
+                best_error = error;
+                x = ix[c];
+                y = iy[c];
             }
+        }
+        return true;
+    }
+    
+    /**
+     * @brief Posición desde una sola bandera con heading conocido.
+     */
+    static void project_from_landmark(const Landmark& lm, Scalar heading, Scalar& x, Scalar& y) {
+        Scalar s, c;
+        scalar::sincos_deg(heading + lm.angle, s, c);
+        x = lm.x - lm.dist * c;
+        y = lm.y - lm.dist * s;
+    }
+    
+    /**
+     * @brief Posición desde una línea lateral (t/b) y una de fondo (l/r).
+     * 
+     * Cada línea fija la coordenada a lo largo de su normal:
+     * offset - distancia perpendicular.
+     */
+    static bool position_from_lines(const LineInfo* lines, uint8_t count, Scalar& x, Scalar& y) {
+        bool has_x = false, has_y = false;
+        for (uint8_t i = 0; i < count; ++i) {
+            if (!FieldLines::is_known(lines[i].id)) continue;
+            const FieldLine& line = FieldLines::get(lines[i].id);
             
-            if (name[4] == 't') {  // Top (y positivo)
-                y = (float)num;
-            } else {  // Bottom
-                y = (float)(-num);
+            Scalar coordinate = Scalar(line.offset) - distance_to_line(lines[i]);
+            Scalar sign = (line.normal >= 0 && line.normal < 180) ? Scalar(1) : Scalar(-1);  // Normal hacia +x / +y
+            if (line.direction == 0) {
+                y = sign * coordinate;
+                has_y = true;
+            } else {
+                x = sign * coordinate;
+                has_x = true;
             }
-            return true;
+        }
+        return has_x && has_y;
+    }
+    
+    /**
+     * @brief RMS de los residuos de distancia en (x, y).
+     */
+    static Scalar range_residual(const Landmark* lm, uint8_t n, Scalar x, Scalar y) {
+        Scalar sum_sq = 0;
+        for (uint8_t i = 0; i < n; ++i) {
+            Scalar dx = x - lm[i].x;
+            Scalar dy = y - lm[i].y;
+            Scalar e = scalar::sqrt(dx * dx + dy * dy) - lm[i].dist;
+            sum_sq += e * e;
+        }
+        return scalar::sqrt(sum_sq / n);
+    }
+    
+    /**
+     * @brief Obtiene la posición conocida de una bandera.
+     * @return true si la bandera es conocida
+     */
+    static bool get_flag_position(FlagId id, Scalar& x, Scalar& y) {
+        if (!FieldFlags::is_known(id)) {
+            return false;
         }
         
-        return false;  // Bandera no conocida
+        const FieldFlag& flag = FieldFlags::get(id);
+        x = flag.x;
+        y = flag.y;
+        return true;
     }
     
     /**
      * @brief Triangulación usando intersección de dos círculos.
      */
-    static PlayerPosition triangulate(float x1, float y1, float r1,
-                                       float x2, float y2, float r2) {
-        // Distancia entre los centros
-        float dx = x2 - x1;
-        float dy = y2 - y1;
-        float d = sqrtf(dx * dx + dy * dy);
-        
-        // Verificar si hay solución
-        if (d > r1 + r2 || d < fabsf(r1 - r2) || d == 0) {
+    static PlayerPosition triangulate(Scalar x1, Scalar y1, Scalar r1,
+                                       Scalar x2, Scalar y2, Scalar r2) {
+        Scalar ix[2], iy[2];
+        if (circle_intersections(x1, y1, r1, x2, y2, r2, ix, iy) == 0) {
             return PlayerPosition();  // No hay intersección
         }
         
-        // Calcular el punto de intersección
-        // Fórmula de intersección de círculos
-        float a = (r1 * r1 - r2 * r2 + d * d) / (2 * d);
-        float h_sq = r1 * r1 - a * a;
-        
-        if (h_sq < 0) {
-            return PlayerPosition();
-        }
-        
-        float h = sqrtf(h_sq);
-        
-        // Punto medio en la línea entre centros
-        float px = x1 + a * dx / d;
-        float py = y1 + a * dy / d;
-        
-        // Dos posibles puntos de intersección
-        float ix1 = px + h * dy / d;
-        float iy1 = py - h * dx / d;
-        float ix2 = px - h * dy / d;
-        float iy2 = py + h * dx / d;
-        
         // Elegir el punto que está dentro del campo (preferiblemente)
         // Campo: -52.5 to 52.5 en X, -34 to 34 en Y
-        bool p1_in = (ix1 >= -55 && ix1 <= 55 && iy1 >= -37 && iy1 <= 37);
-        bool p2_in = (ix2 >= -55 && ix2 <= 55 && iy2 >= -37 && iy2 <= 37);
+        bool p1_in = (ix[0] >= -55 && ix[0] <= 55 && iy[0] >= -37 && iy[0] <= 37);
+        bool p2_in = (ix[1] >= -55 && ix[1] <= 55 && iy[1] >= -37 && iy[1] <= 37);
         
-        if (p1_in && !p2_in) {
-            return PlayerPosition(ix1, iy1, 0);
-        } else if (p2_in && !p1_in) {
-            return PlayerPosition(ix2, iy2, 0);
-        } else {
-            // Ambos o ninguno dentro - usar el primero
-            return PlayerPosition(ix1, iy1, 0);
+        if (p2_in && !p1_in) {
+            return PlayerPosition(ix[1], iy[1], 0);
         }
+        // Sólo el primero, ambos o ninguno dentro - usar el primero
+        return PlayerPosition(ix[0], iy[0], 0);
     }
     
     /**
-     * @brief Normaliza un ángulo al rango [-180, 180].
+     * @brief xorshift32: muestreo determinista sin estado global.
      */
-    static float normalize_angle(float angle) {
-        while (angle > 180.0f) angle -= 360.0f;
-        while (angle < -180.0f) angle += 360.0f;
-        return angle;
+    static uint32_t next_random(uint32_t& state) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
     }
 };
 
+using Localization = BasicLocalization<float>;
+
 } // namespace robocup
 
 #endif // ROBOCUP_LOCALIZATION_H
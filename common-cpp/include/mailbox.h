@@ -0,0 +1,94 @@
+#ifndef ROBOCUP_MAILBOX_H
+#define ROBOCUP_MAILBOX_H
+
+/**
+ * @file mailbox.h
+ * @brief Buzón de último valor entre un productor y un consumidor.
+ *
+ * Pool fijo de tres buffers (triple buffer): el productor llena el suyo y
+ * lo publica, el consumidor toma el más reciente y lo lee en su lugar. Sólo
+ * se intercambian índices con una operación atómica; los datos nunca se
+ * copian ni se bloquea a nadie. Si el productor publica dos veces antes de
+ * que el consumidor tome, el valor anterior se pisa: el consumidor siempre
+ * decide sobre el estado más nuevo y nunca se acumulan estados viejos.
+ *
+ * Uso (un solo productor y un solo consumidor):
+ *
+ *   T& next = mailbox.write_buffer();  // productor
+ *   ... llenar next ...
+ *   mailbox.publish();
+ *
+ *   if (const T* latest = mailbox.take()) { ... }  // consumidor
+ *
+ * El puntero de take() es válido hasta la siguiente llamada a take().
+ */
+
+#include <atomic>
+#include <cstdint>
+
+namespace robocup {
+
+/**
+ * @brief Triple buffer de último valor (SPSC, sin bloqueo).
+ */
+template<typename T>
+class Mailbox {
+public:
+    Mailbox() : write_index_(0), slot_(1), read_index_(2), overwritten_(0) {}
+    
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+    
+    // ========== PRODUCTOR ==========
+    
+    /**
+     * @brief Buffer que el productor llena antes de publish(); sigue siendo suyo hasta entonces.
+     */
+    T& write_buffer() { return buffers_[write_index_]; }
+    
+    /**
+     * @brief Publica write_buffer() y toma otro buffer libre para el próximo valor.
+     * @return true si pisó un valor que el consumidor todavía no había tomado
+     */
+    bool publish() {
+        uint8_t previous = slot_.exchange(write_index_ | FRESH, std::memory_order_acq_rel);
+        write_index_ = previous & INDEX_MASK;
+        if (previous & FRESH) {
+            overwritten_.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+    
+    // ========== CONSUMIDOR ==========
+    
+    /**
+     * @brief Valor publicado más reciente, o nullptr si no hubo uno nuevo desde el último take().
+     */
+    const T* take() {
+        if (!(slot_.load(std::memory_order_acquire) & FRESH)) {
+            return nullptr;
+        }
+        read_index_ = slot_.exchange(read_index_, std::memory_order_acq_rel) & INDEX_MASK;
+        return &buffers_[read_index_];
+    }
+    
+    /**
+     * @brief Valores pisados sin llegar al consumidor.
+     */
+    uint32_t overwritten() const { return overwritten_.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+    static constexpr uint8_t FRESH = 0x04;  // El índice en slot_ no fue tomado aún
+    
+    T buffers_[3];
+    uint8_t write_index_;              // Sólo productor
+    std::atomic<uint8_t> slot_;        // Índice compartido | FRESH
+    uint8_t read_index_;               // Sólo consumidor
+    std::atomic<uint32_t> overwritten_;
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_MAILBOX_H
@@ -7,10 +7,17 @@
  * 
  * Este archivo define las estructuras que son comunes entre la versión PC
  * y la versión ESP32 del agente. No tiene dependencias de sistema operativo.
+ * 
+ * Las estructuras con magnitudes físicas están templadas sobre el escalar
+ * (Basic*<Scalar>); los nombres sin prefijo son los alias para float que
+ * usa el resto del código. Ver fixed_point.h para la variante Q16.16.
  */
 
 #include <cstdint>
 
+#include "field_flags.h"
+#include "fixed_point.h"
+
 namespace robocup {
 
 /**
@@ -51,152 +58,194 @@ enum class ActionType : uint8_t {
 /**
  * @brief Información de un objeto relativo al jugador.
  */
-struct ObjectInfo {
-    float distance;  // Distancia en metros
-    float angle;     // Ángulo en grados (-180 a 180)
-    bool visible;    // Si el objeto es visible
+template<typename Scalar>
+struct BasicObjectInfo {
+    Scalar distance;  // Distancia en metros
+    Scalar angle;     // Ángulo en grados (-180 a 180)
+    bool visible;     // Si el objeto es visible
     
-    ObjectInfo() : distance(0), angle(0), visible(false) {}
-    ObjectInfo(float d, float a) : distance(d), angle(a), visible(true) {}
+    BasicObjectInfo() : distance(0), angle(0), visible(false) {}
+    BasicObjectInfo(Scalar d, Scalar a) : distance(d), angle(a), visible(true) {}
 };
 
+using ObjectInfo = BasicObjectInfo<float>;
+
 /**
  * @brief Información de un compañero de equipo.
  */
-struct TeammateInfo {
+template<typename Scalar>
+struct BasicTeammateInfo {
     uint8_t player_id;
-    float distance;
-    float angle;
+    Scalar distance;
+    Scalar angle;
     bool visible;
     
-    TeammateInfo() : player_id(0), distance(0), angle(0), visible(false) {}
-    TeammateInfo(uint8_t id, float d, float a, bool v = true) 
+    BasicTeammateInfo() : player_id(0), distance(0), angle(0), visible(false) {}
+    BasicTeammateInfo(uint8_t id, Scalar d, Scalar a, bool v = true) 
         : player_id(id), distance(d), angle(a), visible(v) {}
 };
 
+using TeammateInfo = BasicTeammateInfo<float>;
+
 /**
  * @brief Información de una bandera visible para triangulación.
  * 
  * Las banderas son puntos de referencia estáticos en el campo con posiciones
  * conocidas. Se usan para calcular la posición y orientación del jugador.
+ * El nombre se resuelve a FlagId una sola vez al decodificar el mensaje;
+ * las banderas desconocidas se descartan allí y no llegan a SensorData.
  */
-struct FlagInfo {
-    char name[16];     // "f c", "f l t", "g r", etc.
-    float distance;
-    float angle;
-    bool visible;
+template<typename Scalar>
+struct BasicFlagInfo {
+    FlagId id;         // Índice en la tabla de field_flags.h
+    Scalar distance;
+    Scalar angle;
     
-    FlagInfo() : name{0}, distance(0), angle(0), visible(false) {}
-    FlagInfo(const char* n, float d, float a) : distance(d), angle(a), visible(true) {
-        // Copiar el nombre de forma segura
-        for (int i = 0; i < 15 && n[i] != '\0'; ++i) {
-            name[i] = n[i];
-        }
-        name[15] = '\0';
-    }
+    BasicFlagInfo() : id(FlagId::UNKNOWN), distance(0), angle(0) {}
+    BasicFlagInfo(FlagId i, Scalar d, Scalar a) : id(i), distance(d), angle(a) {}
+    BasicFlagInfo(const char* n, Scalar d, Scalar a) : id(FieldFlags::find(n)), distance(d), angle(a) {}
 };
 
+using FlagInfo = BasicFlagInfo<float>;
+
+/**
+ * @brief Información de una línea de borde visible.
+ * 
+ * distance es la distancia sobre la línea de visión hasta el cruce con la
+ * línea y angle el ángulo entre ambas (-90 a 90), tal como los envía el
+ * rcssserver. Se usan para estimar el heading (ver Localization).
+ */
+template<typename Scalar>
+struct BasicLineInfo {
+    LineId id;
+    Scalar distance;
+    Scalar angle;
+    
+    BasicLineInfo() : id(LineId::UNKNOWN), distance(0), angle(0) {}
+    BasicLineInfo(LineId i, Scalar d, Scalar a) : id(i), distance(d), angle(a) {}
+    BasicLineInfo(const char* n, Scalar d, Scalar a) : id(FieldLines::find(n)), distance(d), angle(a) {}
+};
+
+using LineInfo = BasicLineInfo<float>;
+
 /**
  * @brief Posición estimada del jugador en coordenadas absolutas.
  * 
  * Calculada mediante triangulación usando banderas visibles.
  */
-struct PlayerPosition {
-    float x;           // Posición X absoluta (-52.5 a 52.5)
-    float y;           // Posición Y absoluta (-34 a 34)  
-    float heading;     // Orientación absoluta (-180 a 180, 0 = hacia +X/derecha)
+template<typename Scalar>
+struct BasicPlayerPosition {
+    Scalar x;          // Posición X absoluta (-52.5 a 52.5)
+    Scalar y;          // Posición Y absoluta (-34 a 34)  
+    Scalar heading;    // Orientación absoluta (-180 a 180, 0 = hacia +X/derecha)
     bool valid;        // Si la estimación es confiable
     
-    PlayerPosition() : x(0), y(0), heading(0), valid(false) {}
-    PlayerPosition(float px, float py, float h) : x(px), y(py), heading(h), valid(true) {}
+    BasicPlayerPosition() : x(0), y(0), heading(0), valid(false) {}
+    BasicPlayerPosition(Scalar px, Scalar py, Scalar h) : x(px), y(py), heading(h), valid(true) {}
 };
 
+using PlayerPosition = BasicPlayerPosition<float>;
+
 /**
  * @brief Datos de sensores recibidos del backend.
  * 
  * Esta estructura representa el estado del mundo desde la perspectiva
  * del jugador, tal como lo envía el backend Python via MQTT.
  */
-struct SensorData {
+template<typename Scalar>
+struct BasicSensorData {
     GameStatus status;
     PlayerRole role;
     
-    ObjectInfo ball;
-    ObjectInfo goal;
+    BasicObjectInfo<Scalar> ball;
+    BasicObjectInfo<Scalar> goal;
+    
+    // Balón predicho por BallTracker en coordenadas relativas; visible es
+    // false si no hay predicción confiable (ver ball_tracker.h)
+    BasicObjectInfo<Scalar> ball_estimate;
     
     static constexpr uint8_t MAX_TEAMMATES = 10;
-    TeammateInfo teammates[MAX_TEAMMATES];
+    BasicTeammateInfo<Scalar> teammates[MAX_TEAMMATES];
     uint8_t teammate_count;
     
     // Banderas para triangulación
     static constexpr uint8_t MAX_FLAGS = 10;
-    FlagInfo flags[MAX_FLAGS];
+    BasicFlagInfo<Scalar> flags[MAX_FLAGS];
     uint8_t flag_count;
     
+    // Líneas de borde (como mucho se ven dos a la vez)
+    static constexpr uint8_t MAX_LINES = 4;
+    BasicLineInfo<Scalar> lines[MAX_LINES];
+    uint8_t line_count;
+    
     // Posición estimada del jugador
-    PlayerPosition position;
+    BasicPlayerPosition<Scalar> position;
     
     // Información adicional del jugador
-    float stamina;
-    float speed;
+    Scalar stamina;
+    Scalar speed;
     
-    SensorData() 
+    BasicSensorData() 
         : status(GameStatus::IDLE)
         , role(PlayerRole::STRIKER)
         , teammate_count(0)
         , flag_count(0)
+        , line_count(0)
         , stamina(8000)
         , speed(0) {}
 };
 
+using SensorData = BasicSensorData<float>;
+
 /**
  * @brief Acción a ejecutar en el simulador.
  * 
  * Esta estructura se envía al backend Python para ser convertida
  * en comandos RCSSServer.
  */
-struct Action {
+template<typename Scalar>
+struct BasicAction {
     ActionType type;
-    float params[2];
+    Scalar params[2];
     
-    Action() : type(ActionType::NONE), params{0, 0} {}
+    BasicAction() : type(ActionType::NONE), params{0, 0} {}
     
-    static Action none() {
-        return Action();
+    static BasicAction none() {
+        return BasicAction();
     }
     
-    static Action dash(float power, float direction = 0) {
-        Action a;
+    static BasicAction dash(Scalar power, Scalar direction = 0) {
+        BasicAction a;
         a.type = ActionType::DASH;
         a.params[0] = power;
         a.params[1] = direction;
         return a;
     }
     
-    static Action turn(float angle) {
-        Action a;
+    static BasicAction turn(Scalar angle) {
+        BasicAction a;
         a.type = ActionType::TURN;
         a.params[0] = angle;
         return a;
     }
     
-    static Action kick(float power, float direction) {
-        Action a;
+    static BasicAction kick(Scalar power, Scalar direction) {
+        BasicAction a;
         a.type = ActionType::KICK;
         a.params[0] = power;
         a.params[1] = direction;
         return a;
     }
     
-    static Action catch_ball(float direction) {
-        Action a;
+    static BasicAction catch_ball(Scalar direction) {
+        BasicAction a;
         a.type = ActionType::CATCH;
         a.params[0] = direction;
         return a;
     }
     
-    static Action move(float x, float y) {
-        Action a;
+    static BasicAction move(Scalar x, Scalar y) {
+        BasicAction a;
         a.type = ActionType::MOVE;
         a.params[0] = x;
         a.params[1] = y;
@@ -204,6 +253,8 @@ struct Action {
     }
 };
 
+using Action = BasicAction<float>;
+
 /**
  * @brief Mensaje de comunicación entre agentes del equipo.
  */
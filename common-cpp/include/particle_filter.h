@@ -0,0 +1,307 @@
+#ifndef ROBOCUP_PARTICLE_FILTER_H
+#define ROBOCUP_PARTICLE_FILTER_H
+
+/**
+ * @file particle_filter.h
+ * @brief Localización Monte Carlo (filtro de partículas) sin memoria dinámica.
+ *
+ * Alternativa a la triangulación cerrada de Localization. Las partículas
+ * viven en un arena de tamaño fijo (parámetro de plantilla N) con arreglos
+ * separados (SoA) para x, y, heading y peso, de modo que los bucles por
+ * partícula sean vectorizables. El caso ambiguo de dos banderas, que
+ * triangulate() resuelve tomando el primer punto, aquí se resuelve con la
+ * consistencia de los ángulos observados.
+ *
+ * Presupuesto objetivo: < 1 ms por ciclo con N=256 en PC y N=64 en ESP32.
+ */
+
+#include "messages.h"
+#include "localization.h"
+#include "pose_tracker.h"
+#include "fast_math.h"
+#include <cmath>
+#include <cstdint>
+
+namespace robocup {
+
+/**
+ * @brief Parámetros del filtro de partículas.
+ */
+struct ParticleFilterConfig {
+    static constexpr float RANGE_NOISE_ABS = 0.5f;       // metros
+    static constexpr float RANGE_NOISE_REL = 0.05f;      // fracción de la distancia
+    static constexpr float BEARING_NOISE = 3.0f;         // grados
+    static constexpr float INIT_POSITION_NOISE = 1.0f;   // metros, alrededor de cada intersección
+    static constexpr float INIT_HEADING_NOISE = 5.0f;    // grados
+    static constexpr float MAX_SPREAD = 3.0f;            // metros (desvío estándar) para pose válida
+};
+
+/**
+ * @brief Filtro de partículas con N partículas en arreglos SoA.
+ */
+template <uint16_t N>
+class ParticleLocalizer {
+    static_assert(N >= 8, "El filtro necesita al menos 8 partículas");
+
+public:
+    explicit ParticleLocalizer(uint32_t seed = 0x2545F491u) : rng_(seed ? seed : 1) {
+        reset();
+    }
+    
+    void reset() {
+        initialized_ = false;
+        for (uint16_t i = 0; i < N; ++i) {
+            x_[i] = y_[i] = heading_[i] = 0;
+            vx_[i] = vy_[i] = 0;
+            weight_[i] = 1.0f / N;
+        }
+    }
+    
+    bool initialized() const { return initialized_; }
+    
+    static constexpr uint16_t size() { return N; }
+    
+    /**
+     * @brief Movimiento de todas las partículas con la acción ejecutada.
+     */
+    void predict(const Action& action) {
+        if (!initialized_) return;
+        
+        for (uint16_t i = 0; i < N; ++i) {
+            float turn = 0;
+            if (action.type == ActionType::DASH) {
+                float accel = action.params[0] * PoseTrackerConfig::DASH_POWER_RATE;
+                float s, c;
+                fast_math::sincos_deg(heading_[i] + action.params[1], s, c);
+                vx_[i] += accel * c;
+                vy_[i] += accel * s;
+            } else if (action.type == ActionType::TURN) {
+                float speed = sqrtf(vx_[i] * vx_[i] + vy_[i] * vy_[i]);
+                turn = action.params[0] / (1.0f + PoseTrackerConfig::INERTIA_MOMENT * speed);
+            } else if (action.type == ActionType::MOVE) {
+                x_[i] = action.params[0];
+                y_[i] = action.params[1];
+                vx_[i] = vy_[i] = 0;
+                continue;
+            }
+            
+            float speed = sqrtf(vx_[i] * vx_[i] + vy_[i] * vy_[i]);
+            if (speed > PoseTrackerConfig::PLAYER_SPEED_MAX) {
+                vx_[i] *= PoseTrackerConfig::PLAYER_SPEED_MAX / speed;
+                vy_[i] *= PoseTrackerConfig::PLAYER_SPEED_MAX / speed;
+                speed = PoseTrackerConfig::PLAYER_SPEED_MAX;
+            }
+            
+            float pos_sigma = PoseTrackerConfig::POSITION_NOISE + PoseTrackerConfig::SPEED_NOISE_RATIO * speed;
+            float head_sigma = PoseTrackerConfig::HEADING_NOISE + PoseTrackerConfig::TURN_NOISE_RATIO * fabsf(turn);
+            x_[i] += vx_[i] + pos_sigma * gaussian();
+            y_[i] += vy_[i] + pos_sigma * gaussian();
+            heading_[i] = Localization::normalize_angle(heading_[i] + turn + head_sigma * gaussian());
+            vx_[i] *= PoseTrackerConfig::PLAYER_DECAY;
+            vy_[i] *= PoseTrackerConfig::PLAYER_DECAY;
+        }
+    }
+    
+    /**
+     * @brief Pondera las partículas con las banderas visibles y remuestrea.
+     *
+     * Si el filtro no está inicializado, siembra las partículas alrededor de
+     * las dos intersecciones del primer par de banderas (o uniformes en el
+     * campo si no se cortan) y pondera en el mismo ciclo.
+     * @return Número de banderas conocidas usadas
+     */
+    uint8_t update(const FlagInfo* flags, uint8_t count) {
+        float fx[SensorData::MAX_FLAGS], fy[SensorData::MAX_FLAGS];
+        float dist[SensorData::MAX_FLAGS], angle[SensorData::MAX_FLAGS];
+        uint8_t n = 0;
+        for (uint8_t k = 0; k < count && n < SensorData::MAX_FLAGS; ++k) {
+            if (!FieldFlags::is_known(flags[k].id)) continue;
+            const FieldFlag& flag = FieldFlags::get(flags[k].id);
+            fx[n] = flag.x;
+            fy[n] = flag.y;
+            dist[n] = flags[k].distance;
+            angle[n] = flags[k].angle;
+            n++;
+        }
+        
+        if (!initialized_) {
+            if (n < 2) return 0;
+            seed_particles(fx, fy, dist, angle, n);
+        }
+        if (n == 0) return 0;
+        
+        // Log-verosimilitud por partícula, bandera por bandera (bucle interno SoA).
+        // Se reutiliza el buffer de remuestreo para no crecer la pila.
+        float* log_w = scratch_[0];
+        for (uint16_t i = 0; i < N; ++i) log_w[i] = 0;
+        
+        for (uint8_t k = 0; k < n; ++k) {
+            float range_sigma = ParticleFilterConfig::RANGE_NOISE_ABS + ParticleFilterConfig::RANGE_NOISE_REL * dist[k];
+            float inv_range_var = 1.0f / (range_sigma * range_sigma);
+            float inv_bearing_var = 1.0f / (ParticleFilterConfig::BEARING_NOISE * ParticleFilterConfig::BEARING_NOISE);
+            for (uint16_t i = 0; i < N; ++i) {
+                float dx = fx[k] - x_[i];
+                float dy = fy[k] - y_[i];
+                float e_range = sqrtf(dx * dx + dy * dy) - dist[k];
+                float expected = fast_math::atan2_deg(dy, dx) - heading_[i];
+                float e_bearing = Localization::normalize_angle(angle[k] - expected);
+                log_w[i] -= 0.5f * (e_range * e_range * inv_range_var + e_bearing * e_bearing * inv_bearing_var);
+            }
+        }
+        
+        float max_log = log_w[0];
+        for (uint16_t i = 1; i < N; ++i) {
+            if (log_w[i] > max_log) max_log = log_w[i];
+        }
+        float total = 0;
+        for (uint16_t i = 0; i < N; ++i) {
+            weight_[i] *= expf(log_w[i] - max_log);
+            total += weight_[i];
+        }
+        if (!(total > 0)) {
+            // Todas las partículas degeneradas: re-sembrar
+            initialized_ = false;
+            return n;
+        }
+        
+        float sum_sq = 0;
+        for (uint16_t i = 0; i < N; ++i) {
+            weight_[i] /= total;
+            sum_sq += weight_[i] * weight_[i];
+        }
+        if (1.0f / sum_sq < 0.5f * N) {
+            resample();
+        }
+        return n;
+    }
+    
+    /**
+     * @brief Pose media ponderada; inválida si la nube está muy dispersa.
+     */
+    PlayerPosition estimate() const {
+        if (!initialized_) {
+            return PlayerPosition();
+        }
+        
+        float mx = 0, my = 0, s = 0, c = 0;
+        for (uint16_t i = 0; i < N; ++i) {
+            mx += weight_[i] * x_[i];
+            my += weight_[i] * y_[i];
+            float hs, hc;
+            fast_math::sincos_deg(heading_[i], hs, hc);
+            s += weight_[i] * hs;
+            c += weight_[i] * hc;
+        }
+        float var = 0;
+        for (uint16_t i = 0; i < N; ++i) {
+            float dx = x_[i] - mx;
+            float dy = y_[i] - my;
+            var += weight_[i] * (dx * dx + dy * dy);
+        }
+        
+        PlayerPosition pos(mx, my, fast_math::atan2_deg(s, c));
+        pos.valid = var < ParticleFilterConfig::MAX_SPREAD * ParticleFilterConfig::MAX_SPREAD;
+        return pos;
+    }
+    
+    const float* x() const { return x_; }
+    const float* y() const { return y_; }
+    const float* heading() const { return heading_; }
+    const float* weight() const { return weight_; }
+
+private:
+    // Arena SoA: estado actual + buffer para el remuestreo
+    alignas(32) float x_[N];
+    alignas(32) float y_[N];
+    alignas(32) float heading_[N];
+    alignas(32) float weight_[N];
+    alignas(32) float vx_[N];
+    alignas(32) float vy_[N];
+    alignas(32) float scratch_[5][N];
+    
+    uint32_t rng_;
+    bool initialized_;
+    
+    uint32_t next_random() {
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 17;
+        rng_ ^= rng_ << 5;
+        return rng_;
+    }
+    
+    float uniform() {
+        return (next_random() >> 8) * (1.0f / 16777216.0f);  // [0, 1)
+    }
+    
+    /**
+     * @brief Normal aproximada (Irwin-Hall con 4 uniformes), sin log/cos.
+     */
+    float gaussian() {
+        float sum = uniform() + uniform() + uniform() + uniform();
+        return (sum - 2.0f) * 1.7320508f;  // varianza 4/12 -> 1
+    }
+    
+    void seed_particles(const float* fx, const float* fy, const float* dist,
+                        const float* angle, uint8_t n) {
+        // Las dos soluciones del primer par con intersección; la mitad de las
+        // partículas en cada una. La ponderación por ángulos elige la correcta.
+        float cx[2], cy[2];
+        int candidates = 0;
+        for (uint8_t a = 0; a < n && candidates == 0; ++a) {
+            for (uint8_t b = a + 1; b < n && candidates == 0; ++b) {
+                candidates = Localization::circle_intersections(fx[a], fy[a], dist[a], fx[b], fy[b], dist[b], cx, cy);
+            }
+        }
+        
+        for (uint16_t i = 0; i < N; ++i) {
+            if (candidates > 0) {
+                int c = i & 1;
+                x_[i] = cx[c] + ParticleFilterConfig::INIT_POSITION_NOISE * gaussian();
+                y_[i] = cy[c] + ParticleFilterConfig::INIT_POSITION_NOISE * gaussian();
+            } else {
+                x_[i] = (uniform() * 2 - 1) * 52.5f;
+                y_[i] = (uniform() * 2 - 1) * 34.0f;
+            }
+            // Heading consistente con la primera bandera desde esa posición
+            float to_flag = fast_math::atan2_deg(fy[0] - y_[i], fx[0] - x_[i]);
+            heading_[i] = Localization::normalize_angle(
+                to_flag - angle[0] + ParticleFilterConfig::INIT_HEADING_NOISE * gaussian());
+            vx_[i] = vy_[i] = 0;
+            weight_[i] = 1.0f / N;
+        }
+        initialized_ = true;
+    }
+    
+    /**
+     * @brief Remuestreo sistemático: un único número aleatorio, O(N).
+     */
+    void resample() {
+        float step = 1.0f / N;
+        float target = uniform() * step;
+        float cumulative = weight_[0];
+        uint16_t src = 0;
+        for (uint16_t i = 0; i < N; ++i) {
+            while (target > cumulative && src < N - 1) {
+                cumulative += weight_[++src];
+            }
+            scratch_[0][i] = x_[src];
+            scratch_[1][i] = y_[src];
+            scratch_[2][i] = heading_[src];
+            scratch_[3][i] = vx_[src];
+            scratch_[4][i] = vy_[src];
+            target += step;
+        }
+        for (uint16_t i = 0; i < N; ++i) {
+            x_[i] = scratch_[0][i];
+            y_[i] = scratch_[1][i];
+            heading_[i] = scratch_[2][i];
+            vx_[i] = scratch_[3][i];
+            vy_[i] = scratch_[4][i];
+            weight_[i] = step;
+        }
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_PARTICLE_FILTER_H
@@ -0,0 +1,323 @@
+#ifndef ROBOCUP_POSE_TRACKER_H
+#define ROBOCUP_POSE_TRACKER_H
+
+/**
+ * @file pose_tracker.h
+ * @brief Filtro de Kalman extendido para la pose del jugador.
+ *
+ * Mantiene la pose (x, y, heading) entre ciclos: predice con el modelo de
+ * movimiento del rcssserver a partir de la última acción enviada (dead
+ * reckoning) y corrige con las banderas visibles cuando las hay. Sólo
+ * triangula desde cero para inicializarse; después cada bandera es una
+ * actualización escalar de distancia y otra de ángulo, y cada línea de
+ * borde una de heading y otra de distancia perpendicular.
+ */
+
+#include "messages.h"
+#include "localization.h"
+#include "fast_math.h"
+#include <cmath>
+
+namespace robocup {
+
+/**
+ * @brief Parámetros del modelo de movimiento y ruido (valores por defecto del rcssserver).
+ */
+struct PoseTrackerConfig {
+    static constexpr float PLAYER_DECAY = 0.4f;
+    static constexpr float DASH_POWER_RATE = 0.006f;
+    static constexpr float PLAYER_SPEED_MAX = 1.05f;
+    static constexpr float INERTIA_MOMENT = 5.0f;
+    
+    // Ruido de proceso por ciclo
+    static constexpr float POSITION_NOISE = 0.1f;        // metros
+    static constexpr float SPEED_NOISE_RATIO = 0.1f;     // fracción del desplazamiento
+    static constexpr float HEADING_NOISE = 2.0f;         // grados
+    static constexpr float TURN_NOISE_RATIO = 0.1f;      // fracción del giro
+    
+    // Ruido de medición (cuantización del rcssserver)
+    static constexpr float RANGE_NOISE_ABS = 0.1f;       // metros
+    static constexpr float RANGE_NOISE_REL = 0.05f;      // fracción de la distancia
+    static constexpr float BEARING_NOISE = 1.0f;         // grados
+    static constexpr float LINE_ANGLE_NOISE = 1.0f;      // grados
+    
+    // Innovación normalizada máxima aceptada (chi-cuadrado, 1 gdl, ~99.7%)
+    static constexpr float INNOVATION_GATE = 9.0f;
+    
+    // Varianza de posición (x + y) a partir de la cual la pose deja de ser válida
+    static constexpr float MAX_POSITION_VARIANCE = 10.0f;
+    
+    // Ciclos seguidos con la mayoría de las mediciones descartadas antes de
+    // volver a triangular: el jugador fue movido (p. ej. por el servidor tras
+    // un gol). Alguna distancia puede pasar la puerta por casualidad, por eso
+    // no se exige que se descarten todas.
+    static constexpr uint8_t MAX_REJECTED_CYCLES = 3;
+};
+
+/**
+ * @brief EKF de pose con predicción por acciones y corrección por banderas.
+ *
+ * Uso por ciclo:
+ *   tracker.predict(accion_enviada_desde_el_ultimo_estado);
+ *   tracker.correct(sensors.flags, sensors.flag_count, sensors.lines, sensors.line_count);
+ *   sensors.position = tracker.pose();
+ */
+class PoseTracker {
+public:
+    PoseTracker() { reset(); }
+    
+    void reset() {
+        initialized_ = false;
+        rejected_cycles_ = 0;
+        x_ = y_ = heading_ = 0;
+        vx_ = vy_ = 0;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                P_[r][c] = 0;
+            }
+        }
+    }
+    
+    bool initialized() const { return initialized_; }
+    
+    /**
+     * @brief Pose actual; valid es false si nunca se inicializó o la
+     *        incertidumbre de posición creció demasiado sin banderas.
+     */
+    PlayerPosition pose() const {
+        if (!initialized_) {
+            return PlayerPosition();
+        }
+        PlayerPosition pos(x_, y_, heading_);
+        pos.valid = (P_[0][0] + P_[1][1]) < PoseTrackerConfig::MAX_POSITION_VARIANCE;
+        return pos;
+    }
+    
+    /**
+     * @brief Covarianza 3x3 del estado (x, y, heading), en m² y grados².
+     */
+    float covariance(int row, int col) const { return P_[row][col]; }
+    
+    /**
+     * @brief Avanza un ciclo con la acción ejecutada (Action::none() si no hubo).
+     */
+    void predict(const Action& action) {
+        if (!initialized_) return;
+        
+        float turn = 0;
+        switch (action.type) {
+            case ActionType::DASH: {
+                float power = action.params[0];
+                float accel = power * PoseTrackerConfig::DASH_POWER_RATE;
+                float s, c;
+                fast_math::sincos_deg(heading_ + action.params[1], s, c);
+                vx_ += accel * c;
+                vy_ += accel * s;
+                break;
+            }
+            case ActionType::TURN: {
+                float speed = sqrtf(vx_ * vx_ + vy_ * vy_);
+                turn = action.params[0] / (1.0f + PoseTrackerConfig::INERTIA_MOMENT * speed);
+                break;
+            }
+            case ActionType::MOVE:
+                // Teletransporte (sólo antes del kickoff): posición conocida
+                x_ = action.params[0];
+                y_ = action.params[1];
+                vx_ = vy_ = 0;
+                P_[0][0] = P_[1][1] = PoseTrackerConfig::POSITION_NOISE * PoseTrackerConfig::POSITION_NOISE;
+                P_[0][1] = P_[1][0] = 0;
+                P_[0][2] = P_[2][0] = P_[1][2] = P_[2][1] = 0;
+                return;
+            default:
+                break;
+        }
+        
+        float speed = sqrtf(vx_ * vx_ + vy_ * vy_);
+        if (speed > PoseTrackerConfig::PLAYER_SPEED_MAX) {
+            vx_ *= PoseTrackerConfig::PLAYER_SPEED_MAX / speed;
+            vy_ *= PoseTrackerConfig::PLAYER_SPEED_MAX / speed;
+            speed = PoseTrackerConfig::PLAYER_SPEED_MAX;
+        }
+        
+        x_ += vx_;
+        y_ += vy_;
+        heading_ = Localization::normalize_angle(heading_ + turn);
+        vx_ *= PoseTrackerConfig::PLAYER_DECAY;
+        vy_ *= PoseTrackerConfig::PLAYER_DECAY;
+        
+        // El desplazamiento es aditivo en (x, y): el Jacobiano del estado es
+        // la identidad y sólo crece la covarianza con el ruido de proceso.
+        float pos_sigma = PoseTrackerConfig::POSITION_NOISE + PoseTrackerConfig::SPEED_NOISE_RATIO * speed;
+        float head_sigma = PoseTrackerConfig::HEADING_NOISE + PoseTrackerConfig::TURN_NOISE_RATIO * fabsf(turn);
+        P_[0][0] += pos_sigma * pos_sigma;
+        P_[1][1] += pos_sigma * pos_sigma;
+        P_[2][2] += head_sigma * head_sigma;
+    }
+    
+    /**
+     * @brief Corrige con las banderas y líneas visibles del ciclo.
+     *
+     * Si el filtro no está inicializado, lo inicializa con
+     * Localization::estimate_fix (2 banderas, o 1 bandera / 2 líneas si se
+     * ve alguna línea). También vuelve a inicializarse cuando la pose dejó
+     * de ser válida, o cuando la puerta de innovación descartó la mayoría
+     * de las mediciones durante MAX_REJECTED_CYCLES ciclos seguidos: sin esto, un
+     * teletransporte dejaría al filtro rechazando para siempre las banderas
+     * que lo contradicen.
+     * @return Número de mediciones aceptadas (distancia + ángulo cuentan por separado)
+     */
+    int correct(const FlagInfo* flags, uint8_t count,
+                const LineInfo* lines = nullptr, uint8_t line_count = 0) {
+        if (!initialized_ || !pose().valid || rejected_cycles_ >= PoseTrackerConfig::MAX_REJECTED_CYCLES) {
+            int used = initialize(flags, count, lines, line_count);
+            if (used > 0 || !initialized_) {
+                return 2 * used;
+            }
+        }
+        
+        int attempted = 0;
+        int accepted = 0;
+        for (uint8_t i = 0; i < count; ++i) {
+            if (!FieldFlags::is_known(flags[i].id)) continue;
+            const FieldFlag& flag = FieldFlags::get(flags[i].id);
+            
+            float dx = flag.x - x_;
+            float dy = flag.y - y_;
+            float r_sq = dx * dx + dy * dy;
+            float r = sqrtf(r_sq);
+            if (r < 0.5f) continue;  // Geometría degenerada
+            attempted += 2;
+            
+            // Distancia: h = |f - p|, H = [-dx/r, -dy/r, 0]
+            float range_sigma = PoseTrackerConfig::RANGE_NOISE_ABS + PoseTrackerConfig::RANGE_NOISE_REL * flags[i].distance;
+            float H_range[3] = {-dx / r, -dy / r, 0};
+            if (update(H_range, flags[i].distance - r, range_sigma * range_sigma)) {
+                accepted++;
+            }
+            
+            // Ángulo: h = atan2(dy, dx) - heading, en grados
+            dx = flag.x - x_;
+            dy = flag.y - y_;
+            r_sq = dx * dx + dy * dy;
+            float expected = Localization::normalize_angle(fast_math::atan2_deg(dy, dx) - heading_);
+            float H_bearing[3] = {dy / r_sq * fast_math::RAD_TO_DEG, -dx / r_sq * fast_math::RAD_TO_DEG, -1};
+            float innovation = Localization::normalize_angle(flags[i].angle - expected);
+            float bearing_var = PoseTrackerConfig::BEARING_NOISE * PoseTrackerConfig::BEARING_NOISE;
+            if (update(H_bearing, innovation, bearing_var)) {
+                accepted++;
+            }
+        }
+        
+        for (uint8_t i = 0; i < line_count; ++i) {
+            if (!FieldLines::is_known(lines[i].id)) continue;
+            const FieldLine& line = FieldLines::get(lines[i].id);
+            attempted += 2;
+            
+            // Heading: de los dos candidatos (módulo 180) el más cercano al estimado
+            float measured = Localization::normalize_angle(line.direction - lines[i].angle);
+            float innovation = Localization::normalize_angle(measured - heading_);
+            if (innovation > 90.0f) innovation -= 180.0f;
+            if (innovation < -90.0f) innovation += 180.0f;
+            float H_heading[3] = {0, 0, 1};
+            float angle_var = PoseTrackerConfig::LINE_ANGLE_NOISE * PoseTrackerConfig::LINE_ANGLE_NOISE;
+            if (update(H_heading, innovation, angle_var)) {
+                accepted++;
+            }
+            
+            // Distancia perpendicular: h = offset - n·p, H = [-nx, -ny, 0]
+            float nx, ny;
+            fast_math::sincos_deg(line.normal, ny, nx);
+            float expected = line.offset - (nx * x_ + ny * y_);
+            float range_sigma = PoseTrackerConfig::RANGE_NOISE_ABS + PoseTrackerConfig::RANGE_NOISE_REL * lines[i].distance;
+            float H_line[3] = {-nx, -ny, 0};
+            if (update(H_line, Localization::distance_to_line(lines[i]) - expected, range_sigma * range_sigma)) {
+                accepted++;
+            }
+        }
+        heading_ = Localization::normalize_angle(heading_);
+        
+        // Un ciclo sin mediciones no dice nada: no reinicia la cuenta
+        if (attempted > 0 && 2 * accepted >= attempted) {
+            rejected_cycles_ = 0;
+        } else if (attempted > 0 && rejected_cycles_ < PoseTrackerConfig::MAX_REJECTED_CYCLES) {
+            rejected_cycles_++;
+        }
+        return accepted;
+    }
+
+private:
+    bool initialized_;
+    uint8_t rejected_cycles_;  // Ciclos seguidos con la mayoría de las mediciones descartadas
+    float x_, y_, heading_;
+    float vx_, vy_;  // Velocidad en coordenadas de campo (no forma parte del EKF)
+    float P_[3][3];
+    
+    /**
+     * @return Banderas usadas en la inicialización (1 si sólo hubo líneas, 0 si no fue posible)
+     */
+    int initialize(const FlagInfo* flags, uint8_t count, const LineInfo* lines, uint8_t line_count) {
+        PositionFix fix = Localization::estimate_fix(flags, count, lines, line_count);
+        if (!fix.position.valid) {
+            return 0;
+        }
+        
+        x_ = fix.position.x;
+        y_ = fix.position.y;
+        heading_ = fix.position.heading;
+        vx_ = vy_ = 0;
+        
+        // Incertidumbre inicial: residuo de la solución más el ruido típico
+        float pos_sigma = 1.0f + fix.residual;
+        float head_sigma = 5.0f + 5.0f * fix.residual;
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                P_[r][c] = 0;
+            }
+        }
+        P_[0][0] = P_[1][1] = pos_sigma * pos_sigma;
+        P_[2][2] = head_sigma * head_sigma;
+        initialized_ = true;
+        rejected_cycles_ = 0;
+        return fix.flags_used > 0 ? fix.flags_used : 1;
+    }
+    
+    /**
+     * @brief Actualización escalar del EKF con puerta de innovación.
+     * @return false si la medición se descartó por inconsistente
+     */
+    bool update(const float H[3], float innovation, float R) {
+        float PH[3];
+        for (int r = 0; r < 3; ++r) {
+            PH[r] = P_[r][0] * H[0] + P_[r][1] * H[1] + P_[r][2] * H[2];
+        }
+        float S = H[0] * PH[0] + H[1] * PH[1] + H[2] * PH[2] + R;
+        if (S <= 0 || innovation * innovation > PoseTrackerConfig::INNOVATION_GATE * S) {
+            return false;
+        }
+        
+        float K[3] = {PH[0] / S, PH[1] / S, PH[2] / S};
+        x_ += K[0] * innovation;
+        y_ += K[1] * innovation;
+        heading_ += K[2] * innovation;
+        
+        // P = P - K (H P), con H P = PHᵀ por simetría
+        for (int r = 0; r < 3; ++r) {
+            for (int c = 0; c < 3; ++c) {
+                P_[r][c] -= K[r] * PH[c];
+            }
+        }
+        // Mantener simetría numérica
+        for (int r = 0; r < 3; ++r) {
+            for (int c = r + 1; c < 3; ++c) {
+                float avg = 0.5f * (P_[r][c] + P_[c][r]);
+                P_[r][c] = P_[c][r] = avg;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_POSE_TRACKER_H
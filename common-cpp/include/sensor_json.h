@@ -0,0 +1,330 @@
+#ifndef ROBOCUP_SENSOR_JSON_H
+#define ROBOCUP_SENSOR_JSON_H
+
+/**
+ * @file sensor_json.h
+ * @brief Decodificador JSON de una pasada para el estado que publica el backend.
+ *
+ * Recorre el payload una sola vez sobre un std::string_view y escribe
+ * directamente en SensorData, sin copias de strings ni memoria dinámica.
+ * Los números se convierten con std::from_chars (la versión para float
+ * requiere libstdc++ 11 o posterior). Las claves desconocidas se saltan,
+ * de modo que el backend puede agregar campos sin romper al agente.
+ *
+ * Formato esperado (ver RCSSAdapter.to_json_sensors en el backend):
+ *
+ *   {"status": "PLAYING", "role": "STRIKER",
+ *    "sensors": {"ball": {"dist": 10.5, "angle": -15.0},
+ *                "goal": {"dist": 50.0, "angle": 0.0},
+ *                "teammates": [{"id": 2, "dist": 5.0, "angle": 20.0}],
+ *                "flags": [{"name": "f c", "dist": 15.2, "angle": 30}],
+ *                "lines": [{"name": "l r", "dist": 20.5, "angle": -60}]}}
+ *
+ * Los strings no se desescapan: los nombres de banderas, roles y estados
+ * nunca llevan secuencias de escape.
+ */
+
+#include "messages.h"
+#include "field_flags.h"
+#include <charconv>
+#include <cmath>
+#include <string_view>
+
+namespace robocup {
+
+/**
+ * @brief Decodificación de SensorData desde el JSON del backend.
+ */
+class SensorJson {
+public:
+    /**
+     * @brief Decodifica un estado completo; out se reinicia antes de empezar.
+     * @return false si el JSON está mal formado (out queda con lo leído hasta el error)
+     */
+    static bool decode(std::string_view json, SensorData& out) {
+        out = SensorData();
+        Cursor c{json.data(), json.data() + json.size()};
+        bool ok = parse_object(c, 0, [&out](std::string_view key, Cursor& v, int depth) {
+            if (key == "status") return parse_status(v, out.status);
+            if (key == "role") return parse_role(v, out.role);
+            if (key == "sensors") return parse_sensors(v, depth, out);
+            return skip_value(v, depth);
+        });
+        skip_whitespace(c);
+        return ok && c.p == c.end;
+    }
+    
+    /**
+     * @brief Estado de juego a partir del nombre del backend o del referee.
+     */
+    static GameStatus status_from_name(std::string_view name) {
+        if (name == "PLAYING" || name == "play_on") {
+            return GameStatus::PLAYING;
+        }
+        if (name == "BEFORE_KICK_OFF" || name == "before_kick_off" ||
+            name == "kick_off_l" || name == "kick_off_r") {
+            return GameStatus::BEFORE_KICK_OFF;
+        }
+        if (name == "FINISHED") {
+            return GameStatus::FINISHED;
+        }
+        return GameStatus::IDLE;
+    }
+    
+    /**
+     * @return false si el nombre no corresponde a ningún rol (role no cambia)
+     */
+    static bool role_from_name(std::string_view name, PlayerRole& role) {
+        static constexpr struct { const char* name; PlayerRole role; } ROLES[] = {
+            {"STRIKER", PlayerRole::STRIKER},
+            {"DRIBBLER", PlayerRole::DRIBBLER},
+            {"PASSER", PlayerRole::PASSER},
+            {"RECEIVER", PlayerRole::RECEIVER},
+            {"GOALKEEPER", PlayerRole::GOALKEEPER},
+            {"DEFENDER", PlayerRole::DEFENDER},
+            {"STRIKER_GK_SIM", PlayerRole::STRIKER_GK_SIM},
+        };
+        for (const auto& entry : ROLES) {
+            if (name == entry.name) {
+                role = entry.role;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    // Límite de anidamiento al saltar valores desconocidos (el estado usa 3)
+    static constexpr int MAX_DEPTH = 16;
+    
+    struct Cursor {
+        const char* p;
+        const char* end;
+    };
+    
+    /**
+     * @brief Campos de un elemento {name|id, dist, angle} de los arrays.
+     */
+    struct Entry {
+        std::string_view name;
+        float id = 0;
+        float dist = 0;
+        float angle = 0;
+        bool has_dist = false;
+        bool has_angle = false;
+    };
+    
+    // ========== ESTADO ==========
+    
+    static bool parse_status(Cursor& c, GameStatus& status) {
+        std::string_view name;
+        if (!parse_string(c, name)) return false;
+        status = status_from_name(name);
+        return true;
+    }
+    
+    static bool parse_role(Cursor& c, PlayerRole& role) {
+        std::string_view name;
+        if (!parse_string(c, name)) return false;
+        role_from_name(name, role);
+        return true;
+    }
+    
+    static bool parse_sensors(Cursor& c, int depth, SensorData& out) {
+        return parse_object(c, depth, [&out](std::string_view key, Cursor& v, int d) {
+            if (key == "ball") return parse_object_info(v, d, out.ball);
+            if (key == "goal") return parse_object_info(v, d, out.goal);
+            if (key == "teammates") {
+                return parse_entries(v, d, [&out](const Entry& e) {
+                    if (out.teammate_count < SensorData::MAX_TEAMMATES && e.has_dist && e.has_angle &&
+                        e.id >= 0 && e.id <= 255) {
+                        out.teammates[out.teammate_count++] =
+                            TeammateInfo(static_cast<uint8_t>(e.id), e.dist, e.angle);
+                    }
+                });
+            }
+            if (key == "flags") {
+                return parse_entries(v, d, [&out](const Entry& e) {
+                    if (out.flag_count >= SensorData::MAX_FLAGS || !e.has_dist || !e.has_angle) return;
+                    FlagId id = FieldFlags::find(e.name.data(), e.name.size());
+                    if (id != FlagId::UNKNOWN) {
+                        out.flags[out.flag_count++] = FlagInfo(id, e.dist, e.angle);
+                    }
+                });
+            }
+            if (key == "lines") {
+                return parse_entries(v, d, [&out](const Entry& e) {
+                    if (out.line_count >= SensorData::MAX_LINES || !e.has_dist || !e.has_angle) return;
+                    LineId id = FieldLines::find(e.name.data(), e.name.size());
+                    if (id != LineId::UNKNOWN) {
+                        out.lines[out.line_count++] = LineInfo(id, e.dist, e.angle);
+                    }
+                });
+            }
+            return skip_value(v, d);
+        });
+    }
+    
+    /**
+     * @brief {"dist": d, "angle": a}; visible sólo si vienen ambos.
+     */
+    static bool parse_object_info(Cursor& c, int depth, ObjectInfo& info) {
+        Entry e;
+        if (!parse_entry(c, depth, e)) return false;
+        if (e.has_dist && e.has_angle) {
+            info = ObjectInfo(e.dist, e.angle);
+        }
+        return true;
+    }
+    
+    template<typename OnEntry>
+    static bool parse_entries(Cursor& c, int depth, OnEntry&& on_entry) {
+        return parse_array(c, depth, [&on_entry](Cursor& v, int d) {
+            Entry e;
+            if (!parse_entry(v, d, e)) return false;
+            on_entry(e);
+            return true;
+        });
+    }
+    
+    static bool parse_entry(Cursor& c, int depth, Entry& e) {
+        return parse_object(c, depth, [&e](std::string_view key, Cursor& v, int d) {
+            if (key == "dist") {
+                e.has_dist = parse_number(v, e.dist);
+                return e.has_dist;
+            }
+            if (key == "angle") {
+                e.has_angle = parse_number(v, e.angle);
+                return e.has_angle;
+            }
+            if (key == "name") return parse_string(v, e.name);
+            if (key == "id") return parse_number(v, e.id);
+            return skip_value(v, d);
+        });
+    }
+    
+    // ========== TOKENIZER ==========
+    
+    static void skip_whitespace(Cursor& c) {
+        while (c.p < c.end && (*c.p == ' ' || *c.p == '\n' || *c.p == '\r' || *c.p == '\t')) {
+            ++c.p;
+        }
+    }
+    
+    static bool consume(Cursor& c, char expected) {
+        skip_whitespace(c);
+        if (c.p < c.end && *c.p == expected) {
+            ++c.p;
+            return true;
+        }
+        return false;
+    }
+    
+    static bool consume_literal(Cursor& c, std::string_view literal) {
+        if (static_cast<size_t>(c.end - c.p) < literal.size() ||
+            std::string_view(c.p, literal.size()) != literal) {
+            return false;
+        }
+        c.p += literal.size();
+        return true;
+    }
+    
+    /**
+     * @brief Objeto JSON; on_member(clave, cursor, profundidad) consume el valor.
+     *
+     * null se acepta como objeto vacío.
+     */
+    template<typename OnMember>
+    static bool parse_object(Cursor& c, int depth, OnMember&& on_member) {
+        skip_whitespace(c);
+        if (consume_literal(c, "null")) return true;
+        if (depth >= MAX_DEPTH || !consume(c, '{')) return false;
+        if (consume(c, '}')) return true;
+        
+        do {
+            std::string_view key;
+            if (!parse_string(c, key) || !consume(c, ':')) return false;
+            skip_whitespace(c);
+            if (!on_member(key, c, depth + 1)) return false;
+        } while (consume(c, ','));
+        return consume(c, '}');
+    }
+    
+    /**
+     * @brief Array JSON; on_element(cursor, profundidad) consume cada elemento.
+     *
+     * null se acepta como array vacío.
+     */
+    template<typename OnElement>
+    static bool parse_array(Cursor& c, int depth, OnElement&& on_element) {
+        skip_whitespace(c);
+        if (consume_literal(c, "null")) return true;
+        if (depth >= MAX_DEPTH || !consume(c, '[')) return false;
+        if (consume(c, ']')) return true;
+        
+        do {
+            skip_whitespace(c);
+            if (!on_element(c, depth + 1)) return false;
+        } while (consume(c, ','));
+        return consume(c, ']');
+    }
+    
+    /**
+     * @brief String sin desescapar: vista al contenido entre comillas.
+     */
+    static bool parse_string(Cursor& c, std::string_view& out) {
+        if (!consume(c, '"')) return false;
+        const char* start = c.p;
+        while (c.p < c.end && *c.p != '"') {
+            if (*c.p == '\\') ++c.p;  // Saltar el carácter escapado
+            ++c.p;
+        }
+        if (c.p >= c.end) return false;
+        out = std::string_view(start, static_cast<size_t>(c.p - start));
+        ++c.p;
+        return true;
+    }
+    
+    static bool parse_number(Cursor& c, float& out) {
+        skip_whitespace(c);
+        // from_chars acepta nan/inf, que no son JSON: exigir '-' o dígito
+        if (c.p >= c.end || (*c.p != '-' && (*c.p < '0' || *c.p > '9'))) return false;
+        std::from_chars_result r = std::from_chars(c.p, c.end, out);
+        if (r.ec != std::errc() || !std::isfinite(out)) return false;
+        c.p = r.ptr;
+        return true;
+    }
+    
+    static bool skip_value(Cursor& c, int depth) {
+        skip_whitespace(c);
+        if (c.p >= c.end) return false;
+        switch (*c.p) {
+            case '{':
+                return parse_object(c, depth, [](std::string_view, Cursor& v, int d) {
+                    return skip_value(v, d);
+                });
+            case '[':
+                return parse_array(c, depth, [](Cursor& v, int d) {
+                    return skip_value(v, d);
+                });
+            case '"': {
+                std::string_view ignored;
+                return parse_string(c, ignored);
+            }
+            case 't':
+                return consume_literal(c, "true");
+            case 'f':
+                return consume_literal(c, "false");
+            case 'n':
+                return consume_literal(c, "null");
+            default: {
+                float ignored;
+                return parse_number(c, ignored);
+            }
+        }
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_SENSOR_JSON_H
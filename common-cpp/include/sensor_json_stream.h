@@ -0,0 +1,501 @@
+#ifndef ROBOCUP_SENSOR_JSON_STREAM_H
+#define ROBOCUP_SENSOR_JSON_STREAM_H
+
+/**
+ * @file sensor_json_stream.h
+ * @brief Decodificador JSON incremental (push) para el estado del backend.
+ *
+ * Acepta el payload en fragmentos arbitrarios, tal como los entrega
+ * MQTT_EVENT_DATA en el ESP32, y escribe directamente en SensorData a
+ * medida que avanza. No arma un DOM ni necesita el mensaje completo en
+ * memoria: el estado entre fragmentos es una pila de contenedores y un
+ * token de a lo sumo TOKEN_SIZE bytes (clave, string o número en curso).
+ *
+ * Acepta el mismo formato y aplica las mismas reglas que SensorJson::decode
+ * (sensor_json.h), que sigue siendo el camino para payloads ya completos.
+ *
+ * Uso:
+ *
+ *   stream.begin(sensors);
+ *   stream.feed(chunk1, len1);
+ *   stream.feed(chunk2, len2);
+ *   if (stream.finish()) { ... sensors listo ... }
+ */
+
+#include "messages.h"
+#include "field_flags.h"
+#include "sensor_json.h"
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace robocup {
+
+/**
+ * @brief Parser push de SensorData que se reanuda entre fragmentos.
+ */
+class SensorJsonStream {
+public:
+    // Largo máximo de claves, strings y números (los del backend son < 20)
+    static constexpr size_t TOKEN_SIZE = 32;
+    
+    SensorJsonStream() : out_(nullptr) { restart(); }
+    
+    /**
+     * @brief Empieza un mensaje nuevo; out se reinicia y debe seguir vivo hasta finish().
+     */
+    void begin(SensorData& out) {
+        out = SensorData();
+        out_ = &out;
+        restart();
+    }
+    
+    /**
+     * @brief Consume un fragmento del mensaje.
+     * @return false si el JSON ya está mal formado (el resto se ignora)
+     */
+    bool feed(const char* data, size_t size) {
+        if (!out_) return false;
+        for (size_t i = 0; i < size && !error_; ++i) {
+            step(data[i]);
+        }
+        return !error_;
+    }
+    
+    /**
+     * @brief Cierra el mensaje.
+     * @return true si se leyó un documento completo y bien formado
+     */
+    bool finish() {
+        if (!out_) return false;
+        // Un número o literal al final del documento termina con el fin de datos
+        if (!error_ && (state_ == State::IN_NUMBER || state_ == State::IN_LITERAL)) {
+            step(' ');
+        }
+        return !error_ && state_ == State::DONE;
+    }
+    
+    bool failed() const { return error_; }
+
+private:
+    // Mismo límite de anidamiento que SensorJson
+    static constexpr uint8_t MAX_DEPTH = 16;
+    
+    enum class State : uint8_t {
+        VALUE,          // Se espera un valor
+        ARRAY_FIRST,    // Tras '[': valor o ']'
+        OBJECT_FIRST,   // Tras '{': clave o '}'
+        KEY,            // Tras ',' en un objeto: clave
+        IN_KEY,
+        COLON,
+        IN_STRING,
+        IN_NUMBER,
+        IN_LITERAL,
+        AFTER_VALUE,    // ',' o cierre del contenedor
+        DONE            // Sólo queda whitespace
+    };
+    
+    /**
+     * @brief Qué representa el valor en curso según su posición en el documento.
+     */
+    enum class Slot : uint8_t {
+        ROOT, SENSORS, BALL, GOAL,
+        TEAMMATES, FLAGS, LINES,        // Arrays
+        TEAMMATE, FLAG, LINE,           // Sus elementos
+        STATUS, ROLE, NAME, ID, DIST, ANGLE,
+        SKIP                            // Desconocido: se valida y se descarta
+    };
+    
+    struct Frame {
+        Slot slot;
+        bool is_array;
+    };
+    
+    SensorData* out_;
+    State state_;
+    Slot pending_;                      // Slot del próximo valor
+    bool error_;
+    bool escaped_;
+    
+    Frame stack_[MAX_DEPTH];
+    uint8_t depth_;
+    
+    char token_[TOKEN_SIZE];
+    uint8_t token_length_;
+    bool token_overflow_;
+    
+    // Elemento {name|id, dist, angle} en curso
+    char name_[TOKEN_SIZE];
+    uint8_t name_length_;
+    float id_;
+    float dist_;
+    float angle_;
+    bool has_dist_;
+    bool has_angle_;
+    
+    void restart() {
+        state_ = State::VALUE;
+        pending_ = Slot::ROOT;
+        error_ = false;
+        escaped_ = false;
+        depth_ = 0;
+        token_length_ = 0;
+        token_overflow_ = false;
+        reset_entry();
+    }
+    
+    void reset_entry() {
+        name_length_ = 0;
+        id_ = 0;
+        dist_ = 0;
+        angle_ = 0;
+        has_dist_ = false;
+        has_angle_ = false;
+    }
+    
+    static bool is_whitespace(char ch) {
+        return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+    }
+    
+    void begin_token() {
+        token_length_ = 0;
+        token_overflow_ = false;
+        escaped_ = false;
+    }
+    
+    void push_token(char ch) {
+        if (token_length_ < TOKEN_SIZE) {
+            token_[token_length_++] = ch;
+        } else {
+            token_overflow_ = true;
+        }
+    }
+    
+    /**
+     * @brief Token actual; vacío si no entró en el buffer.
+     */
+    std::string_view token() const {
+        return token_overflow_ ? std::string_view() : std::string_view(token_, token_length_);
+    }
+    
+    // ========== AUTÓMATA ==========
+    
+    void step(char ch) {
+        switch (state_) {
+            case State::VALUE:
+                if (!is_whitespace(ch)) start_value(ch);
+                break;
+            
+            case State::ARRAY_FIRST:
+                if (is_whitespace(ch)) break;
+                if (ch == ']') {
+                    close_container(ch);
+                } else {
+                    start_value(ch);
+                }
+                break;
+            
+            case State::OBJECT_FIRST:
+            case State::KEY:
+                if (is_whitespace(ch)) break;
+                if (ch == '}' && state_ == State::OBJECT_FIRST) {
+                    close_container(ch);
+                } else if (ch == '"') {
+                    begin_token();
+                    state_ = State::IN_KEY;
+                } else {
+                    error_ = true;
+                }
+                break;
+            
+            case State::IN_KEY:
+            case State::IN_STRING:
+                // Como en SensorJson, no se desescapa: sólo se salta el carácter escapado
+                if (escaped_) {
+                    escaped_ = false;
+                } else if (ch == '\\') {
+                    escaped_ = true;
+                } else if (ch == '"') {
+                    if (state_ == State::IN_KEY) {
+                        pending_ = child_of(stack_[depth_ - 1].slot, token());
+                        state_ = State::COLON;
+                    } else {
+                        on_string();
+                        after_value();
+                    }
+                    break;
+                }
+                push_token(ch);
+                break;
+            
+            case State::COLON:
+                if (is_whitespace(ch)) break;
+                if (ch == ':') {
+                    state_ = State::VALUE;
+                } else {
+                    error_ = true;
+                }
+                break;
+            
+            case State::IN_NUMBER:
+                if ((ch >= '0' && ch <= '9') || ch == '-' || ch == '+' || ch == '.' || ch == 'e' || ch == 'E') {
+                    push_token(ch);
+                    break;
+                }
+                on_number();
+                after_value();
+                if (!error_) step(ch);
+                break;
+            
+            case State::IN_LITERAL:
+                if (ch >= 'a' && ch <= 'z') {
+                    push_token(ch);
+                    break;
+                }
+                on_literal();
+                after_value();
+                if (!error_) step(ch);
+                break;
+            
+            case State::AFTER_VALUE:
+                if (is_whitespace(ch)) break;
+                if (ch == ',') {
+                    const Frame& top = stack_[depth_ - 1];
+                    if (top.is_array) {
+                        pending_ = element_of(top.slot);
+                        state_ = State::VALUE;
+                    } else {
+                        state_ = State::KEY;
+                    }
+                } else if (ch == '}' || ch == ']') {
+                    close_container(ch);
+                } else {
+                    error_ = true;
+                }
+                break;
+            
+            case State::DONE:
+                if (!is_whitespace(ch)) error_ = true;
+                break;
+        }
+    }
+    
+    void start_value(char ch) {
+        if (ch == '{') {
+            if (!accepts_object(pending_) || depth_ >= MAX_DEPTH) {
+                error_ = true;
+                return;
+            }
+            if (is_entry(pending_)) reset_entry();
+            stack_[depth_++] = Frame{pending_, false};
+            state_ = State::OBJECT_FIRST;
+        } else if (ch == '[') {
+            if (!accepts_array(pending_) || depth_ >= MAX_DEPTH) {
+                error_ = true;
+                return;
+            }
+            stack_[depth_++] = Frame{pending_, true};
+            pending_ = element_of(pending_);
+            state_ = State::ARRAY_FIRST;
+        } else if (ch == '"') {
+            if (!accepts_string(pending_)) {
+                error_ = true;
+                return;
+            }
+            begin_token();
+            state_ = State::IN_STRING;
+        } else if (ch == '-' || (ch >= '0' && ch <= '9')) {
+            if (!accepts_number(pending_)) {
+                error_ = true;
+                return;
+            }
+            begin_token();
+            push_token(ch);
+            state_ = State::IN_NUMBER;
+        } else if (ch >= 'a' && ch <= 'z') {
+            begin_token();
+            push_token(ch);
+            state_ = State::IN_LITERAL;
+        } else {
+            error_ = true;
+        }
+    }
+    
+    void after_value() {
+        if (error_) return;
+        state_ = depth_ == 0 ? State::DONE : State::AFTER_VALUE;
+    }
+    
+    void close_container(char ch) {
+        Frame top = stack_[depth_ - 1];
+        if (top.is_array != (ch == ']')) {
+            error_ = true;
+            return;
+        }
+        --depth_;
+        commit(top.slot);
+        after_value();
+    }
+    
+    // ========== ESQUEMA ==========
+    
+    static Slot child_of(Slot parent, std::string_view key) {
+        switch (parent) {
+            case Slot::ROOT:
+                if (key == "status") return Slot::STATUS;
+                if (key == "role") return Slot::ROLE;
+                if (key == "sensors") return Slot::SENSORS;
+                return Slot::SKIP;
+            case Slot::SENSORS:
+                if (key == "ball") return Slot::BALL;
+                if (key == "goal") return Slot::GOAL;
+                if (key == "teammates") return Slot::TEAMMATES;
+                if (key == "flags") return Slot::FLAGS;
+                if (key == "lines") return Slot::LINES;
+                return Slot::SKIP;
+            case Slot::BALL:
+            case Slot::GOAL:
+            case Slot::TEAMMATE:
+            case Slot::FLAG:
+            case Slot::LINE:
+                if (key == "dist") return Slot::DIST;
+                if (key == "angle") return Slot::ANGLE;
+                if (key == "name") return Slot::NAME;
+                if (key == "id") return Slot::ID;
+                return Slot::SKIP;
+            default:
+                return Slot::SKIP;
+        }
+    }
+    
+    static Slot element_of(Slot array) {
+        switch (array) {
+            case Slot::TEAMMATES: return Slot::TEAMMATE;
+            case Slot::FLAGS: return Slot::FLAG;
+            case Slot::LINES: return Slot::LINE;
+            default: return Slot::SKIP;
+        }
+    }
+    
+    static bool is_entry(Slot s) {
+        return s == Slot::BALL || s == Slot::GOAL || s == Slot::TEAMMATE || s == Slot::FLAG || s == Slot::LINE;
+    }
+    
+    static bool accepts_object(Slot s) {
+        return s == Slot::ROOT || s == Slot::SENSORS || is_entry(s) || s == Slot::SKIP;
+    }
+    
+    static bool accepts_array(Slot s) {
+        return s == Slot::TEAMMATES || s == Slot::FLAGS || s == Slot::LINES || s == Slot::SKIP;
+    }
+    
+    static bool accepts_string(Slot s) {
+        return s == Slot::STATUS || s == Slot::ROLE || s == Slot::NAME || s == Slot::SKIP;
+    }
+    
+    static bool accepts_number(Slot s) {
+        return s == Slot::ID || s == Slot::DIST || s == Slot::ANGLE || s == Slot::SKIP;
+    }
+    
+    // ========== VALORES ==========
+    
+    void on_string() {
+        std::string_view value = token();
+        switch (pending_) {
+            case Slot::STATUS:
+                out_->status = SensorJson::status_from_name(value);
+                break;
+            case Slot::ROLE:
+                SensorJson::role_from_name(value, out_->role);
+                break;
+            case Slot::NAME:
+                name_length_ = static_cast<uint8_t>(value.copy(name_, sizeof(name_)));
+                break;
+            default:
+                break;
+        }
+    }
+    
+    void on_number() {
+        float value = 0;
+        std::from_chars_result r = std::from_chars(token_, token_ + token_length_, value);
+        if (token_overflow_ || r.ec != std::errc() || r.ptr != token_ + token_length_ || !std::isfinite(value)) {
+            error_ = true;
+            return;
+        }
+        switch (pending_) {
+            case Slot::DIST:
+                dist_ = value;
+                has_dist_ = true;
+                break;
+            case Slot::ANGLE:
+                angle_ = value;
+                has_angle_ = true;
+                break;
+            case Slot::ID:
+                id_ = value;
+                break;
+            default:
+                break;
+        }
+    }
+    
+    /**
+     * @brief true/false sólo en valores desconocidos; null también como contenedor vacío.
+     */
+    void on_literal() {
+        std::string_view literal = token();
+        if (literal == "null") {
+            error_ = !(accepts_object(pending_) || accepts_array(pending_));
+        } else if (literal == "true" || literal == "false") {
+            error_ = pending_ != Slot::SKIP;
+        } else {
+            error_ = true;
+        }
+    }
+    
+    /**
+     * @brief Vuelca el objeto que se acaba de cerrar (mismas reglas que SensorJson).
+     */
+    void commit(Slot slot) {
+        bool complete = has_dist_ && has_angle_;
+        switch (slot) {
+            case Slot::BALL:
+                if (complete) out_->ball = ObjectInfo(dist_, angle_);
+                break;
+            case Slot::GOAL:
+                if (complete) out_->goal = ObjectInfo(dist_, angle_);
+                break;
+            case Slot::TEAMMATE:
+                if (out_->teammate_count < SensorData::MAX_TEAMMATES && complete && id_ >= 0 && id_ <= 255) {
+                    out_->teammates[out_->teammate_count++] =
+                        TeammateInfo(static_cast<uint8_t>(id_), dist_, angle_);
+                }
+                break;
+            case Slot::FLAG: {
+                if (out_->flag_count >= SensorData::MAX_FLAGS || !complete) break;
+                FlagId id = FieldFlags::find(name_, name_length_);
+                if (id != FlagId::UNKNOWN) {
+                    out_->flags[out_->flag_count++] = FlagInfo(id, dist_, angle_);
+                }
+                break;
+            }
+            case Slot::LINE: {
+                if (out_->line_count >= SensorData::MAX_LINES || !complete) break;
+                LineId id = FieldLines::find(name_, name_length_);
+                if (id != LineId::UNKNOWN) {
+                    out_->lines[out_->line_count++] = LineInfo(id, dist_, angle_);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_SENSOR_JSON_STREAM_H
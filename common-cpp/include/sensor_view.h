@@ -0,0 +1,211 @@
+#ifndef ROBOCUP_SENSOR_VIEW_H
+#define ROBOCUP_SENSOR_VIEW_H
+
+/**
+ * @file sensor_view.h
+ * @brief Vista de sólo lectura de los sensores de un ciclo.
+ *
+ * SensorDataView lee los campos directamente del payload binario recibido
+ * (wire_format.h) sin copiarlo a un SensorData: cada accesor decodifica
+ * sólo lo que se pide. El buffer debe seguir vivo mientras se use la vista.
+ *
+ * También puede apuntar a un SensorData ya decodificado (p. ej. desde
+ * JSON), de modo que el resto del ciclo del agente tiene un único camino.
+ *
+ * La pose propia y el balón estimado no viajan en el payload: los calcula
+ * el agente y se guardan en la vista con set_position / set_ball_estimate.
+ */
+
+#include "messages.h"
+#include "field_flags.h"
+#include "wire_format.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace robocup {
+
+/**
+ * @brief Acceso a los sensores sin materializar SensorData.
+ */
+class SensorDataView {
+public:
+    SensorDataView() : wire_(nullptr), sensors_(nullptr) {}
+    
+    /**
+     * @brief Apunta la vista a un payload binario de SensorData.
+     * @return false (y la vista queda vacía) si el payload no es válido;
+     *         se aplican las mismas reglas que WireFormat::decode
+     */
+    bool bind(const uint8_t* data, size_t size) {
+        clear();
+        if (!WireFormat::check_sensor_data(data, size)) {
+            return false;
+        }
+        wire_ = data;
+        return true;
+    }
+    
+    /**
+     * @brief Apunta la vista a un SensorData (que debe seguir vivo).
+     */
+    void bind(const SensorData& sensors) {
+        clear();
+        sensors_ = &sensors;
+        position_ = sensors.position;
+        ball_estimate_ = sensors.ball_estimate;
+    }
+    
+    void clear() {
+        wire_ = nullptr;
+        sensors_ = nullptr;
+        position_ = PlayerPosition();
+        ball_estimate_ = ObjectInfo();
+    }
+    
+    bool valid() const { return wire_ || sensors_; }
+    
+    // ========== PAYLOAD ==========
+    
+    GameStatus status() const {
+        if (sensors_) return sensors_->status;
+        return wire_ ? static_cast<GameStatus>(wire_[STATUS]) : GameStatus::IDLE;
+    }
+    
+    PlayerRole role() const {
+        if (sensors_) return sensors_->role;
+        return wire_ ? static_cast<PlayerRole>(wire_[ROLE]) : PlayerRole::STRIKER;
+    }
+    
+    ObjectInfo ball() const {
+        if (sensors_) return sensors_->ball;
+        return object(1, BALL);
+    }
+    
+    ObjectInfo goal() const {
+        if (sensors_) return sensors_->goal;
+        return object(2, GOAL);
+    }
+    
+    float stamina() const {
+        if (sensors_) return sensors_->stamina;
+        return wire_ ? WireFormat::get_u16(wire_ + STAMINA) : SensorData().stamina;
+    }
+    
+    float speed() const {
+        if (sensors_) return sensors_->speed;
+        return wire_ ? WireFormat::get_fixed(wire_ + SPEED) : 0.0f;
+    }
+    
+    uint8_t teammate_count() const { return count(TEAMMATE_COUNT); }
+    uint8_t flag_count() const { return count(FLAG_COUNT); }
+    uint8_t line_count() const { return count(LINE_COUNT); }
+    
+    /**
+     * @param i Índice en [0, teammate_count())
+     */
+    TeammateInfo teammate(uint8_t i) const {
+        if (sensors_) return sensors_->teammates[i];
+        const uint8_t* r = record(i);
+        return TeammateInfo(r[0], WireFormat::get_fixed(r + 1), WireFormat::get_fixed(r + 3));
+    }
+    
+    /**
+     * @param i Índice en [0, flag_count()); un id desconocido se devuelve como FlagId::UNKNOWN
+     */
+    FlagInfo flag(uint8_t i) const {
+        if (sensors_) return sensors_->flags[i];
+        const uint8_t* r = record(teammate_count() + i);
+        FlagId id = static_cast<FlagId>(r[0]);
+        return FlagInfo(FieldFlags::is_known(id) ? id : FlagId::UNKNOWN,
+                        WireFormat::get_fixed(r + 1), WireFormat::get_fixed(r + 3));
+    }
+    
+    /**
+     * @param i Índice en [0, line_count()); un id desconocido se devuelve como LineId::UNKNOWN
+     */
+    LineInfo line(uint8_t i) const {
+        if (sensors_) return sensors_->lines[i];
+        const uint8_t* r = record(teammate_count() + flag_count() + i);
+        LineId id = static_cast<LineId>(r[0]);
+        return LineInfo(FieldLines::is_known(id) ? id : LineId::UNKNOWN,
+                        WireFormat::get_fixed(r + 1), WireFormat::get_fixed(r + 3));
+    }
+    
+    /**
+     * @brief Copia las banderas conocidas al formato que esperan Localization y PoseTracker.
+     * @param out Capacidad >= SensorData::MAX_FLAGS
+     * @return Cantidad copiada
+     */
+    uint8_t copy_flags(FlagInfo* out) const {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < flag_count(); ++i) {
+            FlagInfo f = flag(i);
+            if (f.id != FlagId::UNKNOWN) out[n++] = f;
+        }
+        return n;
+    }
+    
+    /**
+     * @param out Capacidad >= SensorData::MAX_LINES
+     */
+    uint8_t copy_lines(LineInfo* out) const {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < line_count(); ++i) {
+            LineInfo l = line(i);
+            if (l.id != LineId::UNKNOWN) out[n++] = l;
+        }
+        return n;
+    }
+    
+    // ========== ESTADO DERIVADO POR EL AGENTE ==========
+    
+    const PlayerPosition& position() const { return position_; }
+    void set_position(const PlayerPosition& position) { position_ = position; }
+    
+    const ObjectInfo& ball_estimate() const { return ball_estimate_; }
+    void set_ball_estimate(const ObjectInfo& estimate) { ball_estimate_ = estimate; }
+
+private:
+    // Offsets del layout v1 (ver wire_format.h)
+    static constexpr size_t STATUS = WireFormat::STATUS;
+    static constexpr size_t ROLE = WireFormat::ROLE;
+    static constexpr size_t PRESENCE = WireFormat::PRESENCE;
+    static constexpr size_t TEAMMATE_COUNT = WireFormat::TEAMMATE_COUNT;
+    static constexpr size_t FLAG_COUNT = WireFormat::FLAG_COUNT;
+    static constexpr size_t LINE_COUNT = WireFormat::LINE_COUNT;
+    static constexpr size_t BALL = WireFormat::BALL;
+    static constexpr size_t GOAL = WireFormat::GOAL;
+    static constexpr size_t STAMINA = WireFormat::STAMINA;
+    static constexpr size_t SPEED = WireFormat::SPEED;
+    
+    const uint8_t* wire_;
+    const SensorData* sensors_;
+    PlayerPosition position_;
+    ObjectInfo ball_estimate_;
+    
+    uint8_t count(size_t offset) const {
+        if (sensors_) {
+            switch (offset) {
+                case TEAMMATE_COUNT: return sensors_->teammate_count;
+                case FLAG_COUNT: return sensors_->flag_count;
+                default: return sensors_->line_count;
+            }
+        }
+        return wire_ ? wire_[offset] : 0;
+    }
+    
+    ObjectInfo object(uint8_t presence_bit, size_t offset) const {
+        if (!wire_ || !(wire_[PRESENCE] & presence_bit)) {
+            return ObjectInfo();
+        }
+        return ObjectInfo(WireFormat::get_fixed(wire_ + offset), WireFormat::get_fixed(wire_ + offset + 2));
+    }
+    
+    const uint8_t* record(size_t index) const {
+        return wire_ + WireFormat::SENSOR_FIXED_SIZE + WireFormat::RECORD_SIZE * index;
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_SENSOR_VIEW_H
@@ -0,0 +1,194 @@
+#ifndef ROBOCUP_SIMD_H
+#define ROBOCUP_SIMD_H
+
+/**
+ * @file simd.h
+ * @brief Envoltorio mínimo de vectores float para los kernels por lotes.
+ *
+ * Elige en tiempo de compilación el conjunto de instrucciones disponible:
+ *
+ *   __AVX2__     -> 8 floats (__m256)
+ *   __SSE2__     -> 4 floats (__m128)
+ *   __ARM_NEON   -> 4 floats (float32x4_t)
+ *   resto        -> 1 float (fallback escalar)
+ *
+ * Definir ROBOCUP_NO_SIMD fuerza el fallback escalar (útil para comparar).
+ * Sólo expone las operaciones que necesitan los kernels de localización.
+ */
+
+#include <cmath>
+#include <cstdint>
+
+#if !defined(ROBOCUP_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define ROBOCUP_SIMD_AVX2 1
+#elif !defined(ROBOCUP_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define ROBOCUP_SIMD_SSE2 1
+#elif !defined(ROBOCUP_NO_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ROBOCUP_SIMD_NEON 1
+#endif
+
+namespace robocup {
+namespace simd {
+
+#if defined(ROBOCUP_SIMD_AVX2)
+
+constexpr int WIDTH = 8;
+constexpr const char* NAME = "avx2";
+
+struct Mask { __m256 m; };
+struct VecF {
+    __m256 v;
+    static VecF load(const float* p) { return {_mm256_load_ps(p)}; }
+    static VecF broadcast(float s) { return {_mm256_set1_ps(s)}; }
+    void store(float* p) const { _mm256_store_ps(p, v); }
+};
+
+inline VecF operator+(VecF a, VecF b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline VecF operator-(VecF a, VecF b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline VecF operator*(VecF a, VecF b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline VecF operator/(VecF a, VecF b) { return {_mm256_div_ps(a.v, b.v)}; }
+inline VecF sqrt(VecF a) { return {_mm256_sqrt_ps(a.v)}; }
+inline VecF min(VecF a, VecF b) { return {_mm256_min_ps(a.v, b.v)}; }
+inline VecF max(VecF a, VecF b) { return {_mm256_max_ps(a.v, b.v)}; }
+inline VecF abs(VecF a) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v)}; }
+inline Mask operator<(VecF a, VecF b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+inline Mask operator<=(VecF a, VecF b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+inline Mask operator>(VecF a, VecF b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+inline Mask operator>=(VecF a, VecF b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+inline Mask operator&(Mask a, Mask b) { return {_mm256_and_ps(a.m, b.m)}; }
+inline Mask operator|(Mask a, Mask b) { return {_mm256_or_ps(a.m, b.m)}; }
+inline Mask operator!(Mask a) { return {_mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+inline VecF select(Mask m, VecF a, VecF b) { return {_mm256_blendv_ps(b.v, a.v, m.m)}; }
+inline bool any(Mask m) { return _mm256_movemask_ps(m.m) != 0; }
+inline uint32_t bits(Mask m) { return static_cast<uint32_t>(_mm256_movemask_ps(m.m)); }
+
+#elif defined(ROBOCUP_SIMD_SSE2)
+
+constexpr int WIDTH = 4;
+constexpr const char* NAME = "sse2";
+
+struct Mask { __m128 m; };
+struct VecF {
+    __m128 v;
+    static VecF load(const float* p) { return {_mm_load_ps(p)}; }
+    static VecF broadcast(float s) { return {_mm_set1_ps(s)}; }
+    void store(float* p) const { _mm_store_ps(p, v); }
+};
+
+inline VecF operator+(VecF a, VecF b) { return {_mm_add_ps(a.v, b.v)}; }
+inline VecF operator-(VecF a, VecF b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline VecF operator*(VecF a, VecF b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline VecF operator/(VecF a, VecF b) { return {_mm_div_ps(a.v, b.v)}; }
+inline VecF sqrt(VecF a) { return {_mm_sqrt_ps(a.v)}; }
+inline VecF min(VecF a, VecF b) { return {_mm_min_ps(a.v, b.v)}; }
+inline VecF max(VecF a, VecF b) { return {_mm_max_ps(a.v, b.v)}; }
+inline VecF abs(VecF a) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), a.v)}; }
+inline Mask operator<(VecF a, VecF b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+inline Mask operator<=(VecF a, VecF b) { return {_mm_cmple_ps(a.v, b.v)}; }
+inline Mask operator>(VecF a, VecF b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+inline Mask operator>=(VecF a, VecF b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+inline Mask operator&(Mask a, Mask b) { return {_mm_and_ps(a.m, b.m)}; }
+inline Mask operator|(Mask a, Mask b) { return {_mm_or_ps(a.m, b.m)}; }
+inline Mask operator!(Mask a) { return {_mm_xor_ps(a.m, _mm_castsi128_ps(_mm_set1_epi32(-1)))}; }
+// SSE2 no tiene blendv: (m & a) | (~m & b)
+inline VecF select(Mask m, VecF a, VecF b) { return {_mm_or_ps(_mm_and_ps(m.m, a.v), _mm_andnot_ps(m.m, b.v))}; }
+inline bool any(Mask m) { return _mm_movemask_ps(m.m) != 0; }
+inline uint32_t bits(Mask m) { return static_cast<uint32_t>(_mm_movemask_ps(m.m)); }
+
+#elif defined(ROBOCUP_SIMD_NEON)
+
+constexpr int WIDTH = 4;
+constexpr const char* NAME = "neon";
+
+struct Mask { uint32x4_t m; };
+struct VecF {
+    float32x4_t v;
+    static VecF load(const float* p) { return {vld1q_f32(p)}; }
+    static VecF broadcast(float s) { return {vdupq_n_f32(s)}; }
+    void store(float* p) const { vst1q_f32(p, v); }
+};
+
+inline VecF operator+(VecF a, VecF b) { return {vaddq_f32(a.v, b.v)}; }
+inline VecF operator-(VecF a, VecF b) { return {vsubq_f32(a.v, b.v)}; }
+inline VecF operator*(VecF a, VecF b) { return {vmulq_f32(a.v, b.v)}; }
+#if defined(__aarch64__)
+inline VecF operator/(VecF a, VecF b) { return {vdivq_f32(a.v, b.v)}; }
+inline VecF sqrt(VecF a) { return {vsqrtq_f32(a.v)}; }
+#else
+// ARMv7: recíproco estimado + dos pasos de Newton-Raphson
+inline VecF operator/(VecF a, VecF b) {
+    float32x4_t r = vrecpeq_f32(b.v);
+    r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+    r = vmulq_f32(vrecpsq_f32(b.v, r), r);
+    return {vmulq_f32(a.v, r)};
+}
+inline VecF sqrt(VecF a) {
+    float32x4_t r = vrsqrteq_f32(a.v);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a.v, r), r), r);
+    r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a.v, r), r), r);
+    uint32x4_t zero = vceqq_f32(a.v, vdupq_n_f32(0));
+    return {vbslq_f32(zero, vdupq_n_f32(0), vmulq_f32(a.v, r))};
+}
+#endif
+inline VecF min(VecF a, VecF b) { return {vminq_f32(a.v, b.v)}; }
+inline VecF max(VecF a, VecF b) { return {vmaxq_f32(a.v, b.v)}; }
+inline VecF abs(VecF a) { return {vabsq_f32(a.v)}; }
+inline Mask operator<(VecF a, VecF b) { return {vcltq_f32(a.v, b.v)}; }
+inline Mask operator<=(VecF a, VecF b) { return {vcleq_f32(a.v, b.v)}; }
+inline Mask operator>(VecF a, VecF b) { return {vcgtq_f32(a.v, b.v)}; }
+inline Mask operator>=(VecF a, VecF b) { return {vcgeq_f32(a.v, b.v)}; }
+inline Mask operator&(Mask a, Mask b) { return {vandq_u32(a.m, b.m)}; }
+inline Mask operator|(Mask a, Mask b) { return {vorrq_u32(a.m, b.m)}; }
+inline Mask operator!(Mask a) { return {vmvnq_u32(a.m)}; }
+inline VecF select(Mask m, VecF a, VecF b) { return {vbslq_f32(m.m, a.v, b.v)}; }
+inline uint32_t bits(Mask m) {
+    const uint32_t lane_bits[4] = {1, 2, 4, 8};
+    uint32x4_t b = vandq_u32(m.m, vld1q_u32(lane_bits));
+    uint32x2_t s = vadd_u32(vget_low_u32(b), vget_high_u32(b));
+    return vget_lane_u32(vpadd_u32(s, s), 0);
+}
+inline bool any(Mask m) { return bits(m) != 0; }
+
+#else
+
+constexpr int WIDTH = 1;
+constexpr const char* NAME = "scalar";
+
+struct Mask { bool m; };
+struct VecF {
+    float v;
+    static VecF load(const float* p) { return {*p}; }
+    static VecF broadcast(float s) { return {s}; }
+    void store(float* p) const { *p = v; }
+};
+
+inline VecF operator+(VecF a, VecF b) { return {a.v + b.v}; }
+inline VecF operator-(VecF a, VecF b) { return {a.v - b.v}; }
+inline VecF operator*(VecF a, VecF b) { return {a.v * b.v}; }
+inline VecF operator/(VecF a, VecF b) { return {a.v / b.v}; }
+inline VecF sqrt(VecF a) { return {sqrtf(a.v)}; }
+inline VecF min(VecF a, VecF b) { return {a.v < b.v ? a.v : b.v}; }
+inline VecF max(VecF a, VecF b) { return {a.v > b.v ? a.v : b.v}; }
+inline VecF abs(VecF a) { return {fabsf(a.v)}; }
+inline Mask operator<(VecF a, VecF b) { return {a.v < b.v}; }
+inline Mask operator<=(VecF a, VecF b) { return {a.v <= b.v}; }
+inline Mask operator>(VecF a, VecF b) { return {a.v > b.v}; }
+inline Mask operator>=(VecF a, VecF b) { return {a.v >= b.v}; }
+inline Mask operator&(Mask a, Mask b) { return {a.m && b.m}; }
+inline Mask operator|(Mask a, Mask b) { return {a.m || b.m}; }
+inline Mask operator!(Mask a) { return {!a.m}; }
+inline VecF select(Mask m, VecF a, VecF b) { return m.m ? a : b; }
+inline bool any(Mask m) { return m.m; }
+inline uint32_t bits(Mask m) { return m.m ? 1u : 0u; }
+
+#endif
+
+inline VecF operator-(VecF a) { return VecF::broadcast(0.0f) - a; }
+
+} // namespace simd
+} // namespace robocup
+
+#endif // ROBOCUP_SIMD_H
@@ -0,0 +1,85 @@
+#ifndef ROBOCUP_SPSC_RING_H
+#define ROBOCUP_SPSC_RING_H
+
+/**
+ * @file spsc_ring.h
+ * @brief Cola circular sin bloqueo para un productor y un consumidor.
+ *
+ * Pensada para pasar mensajes desde el callback de la librería MQTT (hilo
+ * del productor) al hilo de decisión sin mutex en el camino de datos: cada
+ * lado escribe sólo su propio índice. Cómo despertar al consumidor queda a
+ * cargo del llamador (p. ej. una condition_variable).
+ *
+ * Capacidad fija, potencia de 2. Los índices crecen sin módulo y se
+ * enmascaran al acceder, de modo que lleno (head - tail == CAPACITY) y
+ * vacío (head == tail) se distinguen sin desperdiciar un slot.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace robocup {
+
+/**
+ * @brief Ring SPSC de capacidad fija.
+ */
+template<typename T, size_t CAPACITY>
+class SpscRing {
+    static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY debe ser potencia de 2");
+
+public:
+    SpscRing() : head_(0), tail_(0) {}
+    
+    SpscRing(const SpscRing&) = delete;
+    SpscRing& operator=(const SpscRing&) = delete;
+    
+    /**
+     * @brief Sólo productor.
+     * @return false si está lleno (value no se mueve)
+     */
+    bool push(T&& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == CAPACITY) {
+            return false;
+        }
+        slots_[head & MASK] = std::move(value);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Sólo consumidor.
+     * @return false si está vacío
+     */
+    bool pop(T& out) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        out = std::move(slots_[tail & MASK]);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * @brief Instantánea; desde el consumidor, false garantiza que pop() tendrá éxito.
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+    
+    static constexpr size_t capacity() { return CAPACITY; }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    
+    // En líneas de caché separadas: cada índice lo escribe un solo hilo
+    alignas(64) std::atomic<size_t> head_;  // Próximo slot a escribir
+    alignas(64) std::atomic<size_t> tail_;  // Próximo slot a leer
+    T slots_[CAPACITY];
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_SPSC_RING_H
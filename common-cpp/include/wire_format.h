@@ -0,0 +1,528 @@
+#ifndef ROBOCUP_WIRE_FORMAT_H
+#define ROBOCUP_WIRE_FORMAT_H
+
+/**
+ * @file wire_format.h
+ * @brief Formato binario versionado para SensorData y Action.
+ *
+ * Alternativa compacta al JSON entre backend y agentes. Todos los enteros
+ * son little-endian y el layout es fijo para cada versión:
+ *
+ * Cabecera común (4 bytes)
+ *   0   u8   MAGIC ('R', 0x52; un JSON empieza con '{')
+ *   1   u8   versión
+ *   2   u8   tipo (WireKind)
+ *   3   u8   secuencia (módulo 256; 0 si el emisor no usa deltas)
+ *
+ * SensorData, versión 1 (22 bytes + 5 por registro)
+ *   4   u8   status                5   u8   role
+ *   6   u8   presencia (bit 0: balón, bit 1: arco)
+ *   7   u8   teammate_count        8   u8   flag_count        9   u8   line_count
+ *   10  i16  ball.distance         12  i16  ball.angle
+ *   14  i16  goal.distance         16  i16  goal.angle
+ *   18  u16  stamina               20  i16  speed
+ *   22  registros {u8 id, i16 distance, i16 angle}: teammates, flags, lines
+ *
+ * Delta de SensorData, versión 1 (6 bytes + secciones)
+ *   4   u8   secuencia del keyframe (SensorData completo) de referencia
+ *   5   u8   máscara de secciones presentes, en este orden:
+ *            bit 0: status, role (2)      bit 1: presencia (1)
+ *            bit 2: ball (4)              bit 3: goal (4)
+ *            bit 4: stamina, speed (4)    bits 5-7: teammates, flags, lines
+ *   Las secciones ausentes son iguales al keyframe. Cada lista presente es
+ *   {u8 count, u16 máscara de registros completos} seguida de count
+ *   entradas: el registro completo (5 bytes) si su bit está activo o, si
+ *   no, sólo el id de un registro del keyframe (misma lista) que no cambió.
+ *   Un delta se aplica siempre sobre el keyframe, no sobre el delta
+ *   anterior: perder un delta no afecta a los siguientes.
+ *
+ * Action, versión 1 (9 bytes)
+ *   4   u8   type                  5   i16  params[0]        7   i16  params[1]
+ *
+ * Distancias, ángulos, velocidad y parámetros van en centésimas (x100,
+ * redondeo al más cercano, saturado a int16): la cuantización del
+ * rcssserver (0.1 m, 1°) se conserva sin pérdida. Los ids de banderas y
+ * líneas son los índices de field_flags.h. El codec de referencia del
+ * backend está en backend-python/src/wire_format.py.
+ */
+
+#include "messages.h"
+#include "field_flags.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace robocup {
+
+/**
+ * @brief Tipo de mensaje en el byte 2 de la cabecera.
+ */
+enum class WireKind : uint8_t {
+    SENSOR_DATA = 1,
+    ACTION = 2,
+    SENSOR_DELTA = 3
+};
+
+/**
+ * @brief Codificador/decodificador del formato binario (sin memoria dinámica).
+ */
+class WireFormat {
+public:
+    static constexpr uint8_t MAGIC = 0x52;
+    static constexpr uint8_t VERSION = 1;
+    
+    static constexpr size_t HEADER_SIZE = 4;
+    static constexpr size_t SENSOR_FIXED_SIZE = 22;
+    static constexpr size_t RECORD_SIZE = 5;
+    static constexpr size_t MAX_SENSOR_SIZE = SENSOR_FIXED_SIZE + RECORD_SIZE *
+        (SensorData::MAX_TEAMMATES + SensorData::MAX_FLAGS + SensorData::MAX_LINES);
+    static constexpr size_t DELTA_FIXED_SIZE = 6;
+    static constexpr size_t MAX_DELTA_SIZE = DELTA_FIXED_SIZE + 15 + 3 * 3 + RECORD_SIZE *
+        (SensorData::MAX_TEAMMATES + SensorData::MAX_FLAGS + SensorData::MAX_LINES);
+    static constexpr size_t ACTION_SIZE = 9;
+    
+    static constexpr float SCALE = 100.0f;
+    
+    /**
+     * @brief true si el payload tiene cabecera binaria (si no, es JSON).
+     */
+    static bool is_wire(const uint8_t* data, size_t size) {
+        return size >= HEADER_SIZE && data[0] == MAGIC;
+    }
+    
+    /**
+     * @brief Tamaño codificado de un SensorData.
+     */
+    static size_t encoded_size(const SensorData& in) {
+        return SENSOR_FIXED_SIZE + RECORD_SIZE * (in.teammate_count + in.flag_count + in.line_count);
+    }
+    
+    /**
+     * @brief Secuencia del byte 3 de la cabecera.
+     */
+    static uint8_t sequence(const uint8_t* data) { return data[3]; }
+    
+    /**
+     * @brief Tipo de mensaje (sólo válido si is_wire).
+     */
+    static WireKind kind(const uint8_t* data) { return static_cast<WireKind>(data[2]); }
+    
+    /**
+     * @param sequence Número de secuencia (keyframe) para los deltas
+     * @return Bytes escritos, o 0 si no entra en capacity
+     */
+    static size_t encode(const SensorData& in, uint8_t* out, size_t capacity, uint8_t sequence = 0) {
+        size_t size = encoded_size(in);
+        if (size > capacity || in.teammate_count > SensorData::MAX_TEAMMATES ||
+            in.flag_count > SensorData::MAX_FLAGS || in.line_count > SensorData::MAX_LINES) {
+            return 0;
+        }
+        
+        uint8_t* p = put_header(out, WireKind::SENSOR_DATA, sequence);
+        *p++ = static_cast<uint8_t>(in.status);
+        *p++ = static_cast<uint8_t>(in.role);
+        *p++ = static_cast<uint8_t>((in.ball.visible ? 1 : 0) | (in.goal.visible ? 2 : 0));
+        *p++ = in.teammate_count;
+        *p++ = in.flag_count;
+        *p++ = in.line_count;
+        p = put_fixed(p, in.ball.distance);
+        p = put_fixed(p, in.ball.angle);
+        p = put_fixed(p, in.goal.distance);
+        p = put_fixed(p, in.goal.angle);
+        p = put_u16(p, to_u16(in.stamina));
+        p = put_fixed(p, in.speed);
+        
+        for (uint8_t i = 0; i < in.teammate_count; ++i) {
+            p = put_record(p, in.teammates[i].player_id, in.teammates[i].distance, in.teammates[i].angle);
+        }
+        for (uint8_t i = 0; i < in.flag_count; ++i) {
+            p = put_record(p, static_cast<uint8_t>(in.flags[i].id), in.flags[i].distance, in.flags[i].angle);
+        }
+        for (uint8_t i = 0; i < in.line_count; ++i) {
+            p = put_record(p, static_cast<uint8_t>(in.lines[i].id), in.lines[i].distance, in.lines[i].angle);
+        }
+        return size;
+    }
+    
+    /**
+     * @brief Decodifica un SensorData; out se reinicia antes de empezar.
+     *
+     * Rechaza cabeceras ajenas, versiones futuras, tamaños que no
+     * coinciden con los contadores y enums fuera de rango. Las banderas o
+     * líneas con id desconocido se descartan.
+     */
+    static bool decode(const uint8_t* data, size_t size, SensorData& out) {
+        out = SensorData();
+        if (!check_sensor_data(data, size)) {
+            return false;
+        }
+        
+        const uint8_t* p = data + HEADER_SIZE;
+        uint8_t presence = p[2];
+        uint8_t teammates = p[3];
+        uint8_t flags = p[4];
+        uint8_t lines = p[5];
+        out.status = static_cast<GameStatus>(p[0]);
+        out.role = static_cast<PlayerRole>(p[1]);
+        p += 6;
+        
+        if (presence & 1) out.ball = ObjectInfo(get_fixed(p), get_fixed(p + 2));
+        if (presence & 2) out.goal = ObjectInfo(get_fixed(p + 4), get_fixed(p + 6));
+        out.stamina = get_u16(p + 8);
+        out.speed = get_fixed(p + 10);
+        p += 12;
+        
+        for (uint8_t i = 0; i < teammates; ++i, p += RECORD_SIZE) {
+            out.teammates[out.teammate_count++] = TeammateInfo(p[0], get_fixed(p + 1), get_fixed(p + 3));
+        }
+        for (uint8_t i = 0; i < flags; ++i, p += RECORD_SIZE) {
+            FlagId id = static_cast<FlagId>(p[0]);
+            if (FieldFlags::is_known(id)) {
+                out.flags[out.flag_count++] = FlagInfo(id, get_fixed(p + 1), get_fixed(p + 3));
+            }
+        }
+        for (uint8_t i = 0; i < lines; ++i, p += RECORD_SIZE) {
+            LineId id = static_cast<LineId>(p[0]);
+            if (FieldLines::is_known(id)) {
+                out.lines[out.line_count++] = LineInfo(id, get_fixed(p + 1), get_fixed(p + 3));
+            }
+        }
+        return true;
+    }
+    
+    // ========== DELTAS ==========
+    
+    /**
+     * @brief Delta de current respecto de keyframe (ambos SensorData codificados).
+     *
+     * La comparación es sobre los valores cuantizados, de modo que un
+     * cambio por debajo de la centésima no se transmite.
+     * @param sequence Secuencia de este mensaje; la del keyframe se toma de su cabecera
+     * @param capacity Debe ser >= MAX_DELTA_SIZE
+     * @return Bytes escritos, o 0 si algún payload no es válido
+     */
+    static size_t encode_delta(const uint8_t* keyframe, size_t keyframe_size,
+                               const uint8_t* current, size_t current_size,
+                               uint8_t sequence, uint8_t* out, size_t capacity) {
+        if (capacity < MAX_DELTA_SIZE || !check_sensor_data(keyframe, keyframe_size) ||
+            !check_sensor_data(current, current_size)) {
+            return 0;
+        }
+        
+        uint8_t* p = put_header(out, WireKind::SENSOR_DELTA, sequence);
+        *p++ = keyframe[3];
+        uint8_t& mask = *p++;
+        mask = 0;
+        for (uint8_t s = 0; s < FIXED_SECTION_COUNT; ++s) {
+            const Section& section = FIXED_SECTIONS[s];
+            if (std::memcmp(keyframe + section.offset, current + section.offset, section.size) != 0) {
+                mask |= static_cast<uint8_t>(1u << s);
+                std::memcpy(p, current + section.offset, section.size);
+                p += section.size;
+            }
+        }
+        
+        const uint8_t* kf_list = keyframe + SENSOR_FIXED_SIZE;
+        const uint8_t* cur_list = current + SENSOR_FIXED_SIZE;
+        for (uint8_t l = 0; l < LIST_COUNT; ++l) {
+            uint8_t kf_count = keyframe[TEAMMATE_COUNT + l];
+            uint8_t cur_count = current[TEAMMATE_COUNT + l];
+            if (kf_count != cur_count || std::memcmp(kf_list, cur_list, RECORD_SIZE * cur_count) != 0) {
+                mask |= static_cast<uint8_t>(1u << (FIXED_SECTION_COUNT + l));
+                p = put_list_delta(kf_list, kf_count, cur_list, cur_count, p);
+            }
+            kf_list += RECORD_SIZE * kf_count;
+            cur_list += RECORD_SIZE * cur_count;
+        }
+        return static_cast<size_t>(p - out);
+    }
+    
+    /**
+     * @brief Reconstruye el SensorData completo a partir del keyframe y un delta.
+     *
+     * El resultado lleva la cabecera de un SensorData con la secuencia del
+     * delta, así que se decodifica o se envuelve en una SensorDataView
+     * igual que un keyframe.
+     * @param capacity Debe ser >= MAX_SENSOR_SIZE
+     * @return Bytes escritos, o 0 si el delta no es válido o no
+     *         corresponde a ese keyframe
+     */
+    static size_t apply_delta(const uint8_t* keyframe, size_t keyframe_size,
+                              const uint8_t* delta, size_t delta_size,
+                              uint8_t* out, size_t capacity) {
+        if (capacity < MAX_SENSOR_SIZE || !check_sensor_data(keyframe, keyframe_size) ||
+            !check_header(delta, delta_size, WireKind::SENSOR_DELTA) ||
+            delta_size < DELTA_FIXED_SIZE || delta[4] != keyframe[3]) {
+            return 0;
+        }
+        
+        const uint8_t* p = delta + DELTA_FIXED_SIZE;
+        const uint8_t* end = delta + delta_size;
+        uint8_t mask = delta[5];
+        std::memcpy(out, keyframe, SENSOR_FIXED_SIZE);
+        out[3] = delta[3];
+        for (uint8_t s = 0; s < FIXED_SECTION_COUNT; ++s) {
+            const Section& section = FIXED_SECTIONS[s];
+            if (!(mask & (1u << s))) continue;
+            if (static_cast<size_t>(end - p) < section.size) return 0;
+            std::memcpy(out + section.offset, p, section.size);
+            p += section.size;
+        }
+        
+        const uint8_t* kf_list = keyframe + SENSOR_FIXED_SIZE;
+        uint8_t* w = out + SENSOR_FIXED_SIZE;
+        for (uint8_t l = 0; l < LIST_COUNT; ++l) {
+            uint8_t kf_count = keyframe[TEAMMATE_COUNT + l];
+            if (mask & (1u << (FIXED_SECTION_COUNT + l))) {
+                p = apply_list_delta(kf_list, kf_count, LIST_MAX[l], p, end, w, out[TEAMMATE_COUNT + l]);
+                if (!p) return 0;
+            } else {
+                std::memcpy(w, kf_list, RECORD_SIZE * kf_count);
+                w += RECORD_SIZE * kf_count;
+                out[TEAMMATE_COUNT + l] = kf_count;
+            }
+            kf_list += RECORD_SIZE * kf_count;
+        }
+        
+        size_t size = static_cast<size_t>(w - out);
+        return p == end && check_sensor_data(out, size) ? size : 0;
+    }
+    
+    /**
+     * @return Bytes escritos (ACTION_SIZE), o 0 si no entra en capacity
+     */
+    static size_t encode(const Action& in, uint8_t* out, size_t capacity) {
+        if (capacity < ACTION_SIZE) {
+            return 0;
+        }
+        uint8_t* p = put_header(out, WireKind::ACTION);
+        *p++ = static_cast<uint8_t>(in.type);
+        p = put_fixed(p, in.params[0]);
+        put_fixed(p, in.params[1]);
+        return ACTION_SIZE;
+    }
+    
+    static bool decode(const uint8_t* data, size_t size, Action& out) {
+        out = Action();
+        if (!check_header(data, size, WireKind::ACTION) || size != ACTION_SIZE ||
+            data[4] > static_cast<uint8_t>(ActionType::MOVE)) {
+            return false;
+        }
+        out.type = static_cast<ActionType>(data[4]);
+        out.params[0] = get_fixed(data + 5);
+        out.params[1] = get_fixed(data + 7);
+        return true;
+    }
+
+private:
+    friend class SensorDataView;
+    friend class SensorStream;
+    
+    // Offsets del layout de SensorData v1
+    static constexpr size_t STATUS = 4;
+    static constexpr size_t ROLE = 5;
+    static constexpr size_t PRESENCE = 6;
+    static constexpr size_t TEAMMATE_COUNT = 7;  // Seguido de FLAG_COUNT y LINE_COUNT
+    static constexpr size_t FLAG_COUNT = 8;
+    static constexpr size_t LINE_COUNT = 9;
+    static constexpr size_t BALL = 10;
+    static constexpr size_t GOAL = 14;
+    static constexpr size_t STAMINA = 18;
+    static constexpr size_t SPEED = 20;
+    
+    /**
+     * @brief Tramo de la parte fija que un delta transmite entero si cambió.
+     */
+    struct Section {
+        size_t offset;
+        size_t size;
+    };
+    static constexpr uint8_t FIXED_SECTION_COUNT = 5;
+    static constexpr Section FIXED_SECTIONS[FIXED_SECTION_COUNT] = {
+        {STATUS, 2}, {PRESENCE, 1}, {BALL, 4}, {GOAL, 4}, {STAMINA, 4}
+    };
+    static constexpr uint8_t LIST_COUNT = 3;
+    static constexpr uint8_t LIST_MAX[LIST_COUNT] = {
+        SensorData::MAX_TEAMMATES, SensorData::MAX_FLAGS, SensorData::MAX_LINES
+    };
+    
+    /**
+     * @brief Cabecera, rangos de los enums y tamaño coherente con los contadores.
+     */
+    static bool check_sensor_data(const uint8_t* data, size_t size) {
+        if (!check_header(data, size, WireKind::SENSOR_DATA) || size < SENSOR_FIXED_SIZE) {
+            return false;
+        }
+        const uint8_t* p = data + HEADER_SIZE;
+        return p[0] <= static_cast<uint8_t>(GameStatus::FINISHED) &&
+               p[1] <= static_cast<uint8_t>(PlayerRole::STRIKER_GK_SIM) &&
+               p[3] <= SensorData::MAX_TEAMMATES && p[4] <= SensorData::MAX_FLAGS &&
+               p[5] <= SensorData::MAX_LINES &&
+               size == SENSOR_FIXED_SIZE + RECORD_SIZE * (p[3] + p[4] + p[5]);
+    }
+    
+    static bool check_header(const uint8_t* data, size_t size, WireKind kind) {
+        return is_wire(data, size) && data[1] == VERSION &&
+               data[2] == static_cast<uint8_t>(kind);
+    }
+    
+    static uint8_t* put_header(uint8_t* p, WireKind kind, uint8_t sequence = 0) {
+        p[0] = MAGIC;
+        p[1] = VERSION;
+        p[2] = static_cast<uint8_t>(kind);
+        p[3] = sequence;
+        return p + HEADER_SIZE;
+    }
+    
+    /**
+     * @brief Primer registro de la lista con ese id, o nullptr.
+     */
+    static const uint8_t* find_record(const uint8_t* list, uint8_t count, uint8_t id) {
+        for (uint8_t i = 0; i < count; ++i, list += RECORD_SIZE) {
+            if (list[0] == id) return list;
+        }
+        return nullptr;
+    }
+    
+    static uint8_t* put_list_delta(const uint8_t* kf_list, uint8_t kf_count,
+                                   const uint8_t* cur_list, uint8_t cur_count, uint8_t* p) {
+        *p++ = cur_count;
+        uint8_t* full_mask = p;
+        p += 2;
+        uint16_t full = 0;
+        for (uint8_t i = 0; i < cur_count; ++i, cur_list += RECORD_SIZE) {
+            const uint8_t* match = find_record(kf_list, kf_count, cur_list[0]);
+            if (match && std::memcmp(match, cur_list, RECORD_SIZE) == 0) {
+                *p++ = cur_list[0];
+            } else {
+                full |= static_cast<uint16_t>(1u << i);
+                std::memcpy(p, cur_list, RECORD_SIZE);
+                p += RECORD_SIZE;
+            }
+        }
+        put_u16(full_mask, full);
+        return p;
+    }
+    
+    /**
+     * @return Posición tras la lista en el delta, o nullptr si es inválida
+     */
+    static const uint8_t* apply_list_delta(const uint8_t* kf_list, uint8_t kf_count, uint8_t max_count,
+                                           const uint8_t* p, const uint8_t* end,
+                                           uint8_t*& w, uint8_t& count) {
+        if (end - p < 3 || p[0] > max_count) return nullptr;
+        count = p[0];
+        uint16_t full = get_u16(p + 1);
+        p += 3;
+        for (uint8_t i = 0; i < count; ++i) {
+            const uint8_t* record = p;
+            size_t consumed = RECORD_SIZE;
+            if (!(full & (1u << i))) {
+                record = p < end ? find_record(kf_list, kf_count, p[0]) : nullptr;
+                consumed = 1;
+            }
+            if (!record || static_cast<size_t>(end - p) < consumed) return nullptr;
+            std::memcpy(w, record, RECORD_SIZE);
+            w += RECORD_SIZE;
+            p += consumed;
+        }
+        return p;
+    }
+    
+    static uint8_t* put_u16(uint8_t* p, uint16_t v) {
+        p[0] = static_cast<uint8_t>(v);
+        p[1] = static_cast<uint8_t>(v >> 8);
+        return p + 2;
+    }
+    
+    static uint16_t get_u16(const uint8_t* p) {
+        return static_cast<uint16_t>(p[0] | (p[1] << 8));
+    }
+    
+    /**
+     * @brief value * SCALE redondeado y saturado a int16.
+     */
+    static uint8_t* put_fixed(uint8_t* p, float value) {
+        float scaled = value * SCALE;
+        int32_t v = scaled >= 32767.0f ? 32767
+                  : scaled <= -32768.0f ? -32768
+                  : static_cast<int32_t>(scaled + (scaled >= 0 ? 0.5f : -0.5f));
+        return put_u16(p, static_cast<uint16_t>(v));
+    }
+    
+    static float get_fixed(const uint8_t* p) {
+        return static_cast<int16_t>(get_u16(p)) / SCALE;
+    }
+    
+    static uint16_t to_u16(float value) {
+        if (value <= 0) return 0;
+        if (value >= 65535.0f) return 65535;
+        return static_cast<uint16_t>(value + 0.5f);
+    }
+    
+    static uint8_t* put_record(uint8_t* p, uint8_t id, float distance, float angle) {
+        *p++ = id;
+        p = put_fixed(p, distance);
+        return put_fixed(p, angle);
+    }
+};
+
+/**
+ * @brief Lado receptor de keyframes + deltas.
+ *
+ * Guarda el último keyframe y devuelve cada estado recibido como un
+ * SensorData completo codificado (listo para WireFormat::decode o una
+ * SensorDataView). Un delta cuyo keyframe no se recibió se descarta hasta
+ * el próximo keyframe periódico.
+ */
+class SensorStream {
+public:
+    SensorStream() : keyframe_size_(0), keyframes_(0), deltas_(0), dropped_(0) {}
+    
+    void reset() { keyframe_size_ = 0; }
+    
+    /**
+     * @param[out] size Tamaño del estado devuelto
+     * @return Estado completo (válido hasta la próxima llamada), o nullptr
+     *         si el mensaje no es un estado válido o falta su keyframe
+     */
+    const uint8_t* receive(const uint8_t* data, size_t size, size_t& out_size) {
+        out_size = 0;
+        if (WireFormat::is_wire(data, size) && WireFormat::kind(data) == WireKind::SENSOR_DELTA) {
+            out_size = keyframe_size_ == 0 ? 0 : WireFormat::apply_delta(keyframe_, keyframe_size_, data, size,
+                                                                         current_, sizeof(current_));
+            if (out_size == 0) {
+                dropped_++;
+                return nullptr;
+            }
+            deltas_++;
+            return current_;
+        }
+        
+        if (!WireFormat::check_sensor_data(data, size)) {
+            dropped_++;
+            return nullptr;
+        }
+        std::memcpy(keyframe_, data, size);
+        keyframe_size_ = size;
+        keyframes_++;
+        out_size = size;
+        return keyframe_;
+    }
+    
+    uint32_t keyframes() const { return keyframes_; }
+    uint32_t deltas() const { return deltas_; }
+    uint32_t dropped() const { return dropped_; }
+
+private:
+    uint8_t keyframe_[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t current_[WireFormat::MAX_SENSOR_SIZE];
+    size_t keyframe_size_;
+    uint32_t keyframes_;
+    uint32_t deltas_;
+    uint32_t dropped_;
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_WIRE_FORMAT_H
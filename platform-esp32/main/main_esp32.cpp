@@ -8,23 +8,31 @@
 
 #include <cstdio>
 #include <cstring>
+#include <atomic>
+#include <string_view>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
-#include "freertos/queue.h"
 
 #include "esp_log.h"
 #include "esp_wifi.h"
 #include "esp_event.h"
+#include "esp_timer.h"
 #include "esp_system.h"
 #include "nvs_flash.h"
 #include "mqtt_client.h"
-#include "cJSON.h"
 
 // Incluir lógica compartida
 #include "game_logic.h"
 #include "messages.h"
+#include "pose_tracker.h"
+#include "ball_tracker.h"
+#include "wire_format.h"
+#include "sensor_view.h"
+#include "sensor_json_stream.h"
+#include "action_json.h"
+#include "mailbox.h"
 
 static const char* TAG = "ROBOCUP_AGENT";
 
@@ -45,6 +53,11 @@ static const char* TAG = "ROBOCUP_AGENT";
 // Rate limiting
 #define MIN_SEND_INTERVAL_MS 75
 
+// Presupuesto por estado, desde el último fragmento hasta la acción publicada.
+// El servidor avanza cada 100 ms; el resto queda para la red y el backend
+#define CYCLE_BUDGET_US      20000
+#define CYCLE_REPORT_EVERY   100   // Ciclos entre reportes de tiempos
+
 // =============================================================================
 // Variables globales
 // =============================================================================
@@ -53,9 +66,29 @@ static EventGroupHandle_t wifi_event_group;
 static const int WIFI_CONNECTED_BIT = BIT0;
 
 static esp_mqtt_client_handle_t mqtt_client = nullptr;
-static QueueHandle_t sensor_queue = nullptr;
+static TaskHandle_t agent_task_handle = nullptr;
 
 static robocup::GameLogic game_logic;
+static robocup::PoseTracker pose_tracker;
+static robocup::BallTracker ball_tracker;
+
+// El último estado llegó en formato binario: las acciones se responden igual
+static std::atomic<bool> binary_peer{false};
+
+/**
+ * @brief Estado en formato binario tal como viaja por state_mailbox.
+ *
+ * ~140 bytes en lugar de un SensorData completo; un estado JSON se
+ * re-codifica al llegar para que la tarea del agente tenga un solo camino.
+ */
+struct StatePacket {
+    int64_t received_us;  // esp_timer_get_time() al completar el mensaje
+    uint16_t size;
+    uint8_t data[robocup::WireFormat::MAX_SENSOR_SIZE];
+};
+
+// Último estado recibido: el handler MQTT publica, agent_task toma
+static robocup::Mailbox<StatePacket> state_mailbox;
 
 // =============================================================================
 // WiFi
@@ -110,104 +143,129 @@ static void wifi_init() {
 // MQTT
 // =============================================================================
 
-static robocup::SensorData parse_sensor_json(const char* json_str) {
-    robocup::SensorData sensors;
+static void publish_action(const robocup::Action& action) {
+    if (!mqtt_client) return;
     
-    cJSON* root = cJSON_Parse(json_str);
-    if (!root) {
-        ESP_LOGW(TAG, "Failed to parse JSON");
-        return sensors;
+    if (binary_peer) {
+        uint8_t wire[robocup::WireFormat::ACTION_SIZE];
+        int size = static_cast<int>(robocup::WireFormat::encode(action, wire, sizeof(wire)));
+        esp_mqtt_client_publish(mqtt_client, TOPIC_ACTION, reinterpret_cast<const char*>(wire), size, 1, 0);
+        ESP_LOGD(TAG, "Published binary action %d", static_cast<int>(action.type));
+        return;
     }
     
-    // Status
-    cJSON* status = cJSON_GetObjectItem(root, "status");
-    if (status && cJSON_IsString(status)) {
-        if (strcmp(status->valuestring, "PLAYING") == 0 ||
-            strcmp(status->valuestring, "play_on") == 0) {
-            sensors.status = robocup::GameStatus::PLAYING;
-        } else if (strcmp(status->valuestring, "BEFORE_KICK_OFF") == 0 ||
-                   strcmp(status->valuestring, "before_kick_off") == 0 ||
-                   strcmp(status->valuestring, "kick_off_l") == 0 ||
-                   strcmp(status->valuestring, "kick_off_r") == 0) {
-            sensors.status = robocup::GameStatus::BEFORE_KICK_OFF;
-        } else if (strcmp(status->valuestring, "FINISHED") == 0) {
-            sensors.status = robocup::GameStatus::FINISHED;
-        }
-    }
+    // Sin printf de floats: ActionJson formatea en décimas con to_chars
+    char buffer[robocup::ActionJson::MAX_SIZE];
+    int size = static_cast<int>(robocup::ActionJson::encode(action, buffer, sizeof(buffer)));
     
-    // Role
-    cJSON* role = cJSON_GetObjectItem(root, "role");
-    if (role && cJSON_IsString(role)) {
-        // IMPORTANTE: STRIKER_GK_SIM debe ir ANTES de STRIKER porque contiene "STRIKER"
-        if (strcmp(role->valuestring, "STRIKER_GK_SIM") == 0) {
-            sensors.role = robocup::PlayerRole::STRIKER_GK_SIM;
-        } else if (strcmp(role->valuestring, "STRIKER") == 0) {
-            sensors.role = robocup::PlayerRole::STRIKER;
-        } else if (strcmp(role->valuestring, "GOALKEEPER") == 0) {
-            sensors.role = robocup::PlayerRole::GOALKEEPER;
-        } else if (strcmp(role->valuestring, "DRIBBLER") == 0) {
-            sensors.role = robocup::PlayerRole::DRIBBLER;
-        } else if (strcmp(role->valuestring, "DEFENDER") == 0) {
-            sensors.role = robocup::PlayerRole::DEFENDER;
-        } else if (strcmp(role->valuestring, "PASSER") == 0) {
-            sensors.role = robocup::PlayerRole::PASSER;
-        } else if (strcmp(role->valuestring, "RECEIVER") == 0) {
-            sensors.role = robocup::PlayerRole::RECEIVER;
-        }
+    esp_mqtt_client_publish(mqtt_client, TOPIC_ACTION, buffer, size, 1, 0);
+    ESP_LOGD(TAG, "Published: %s", buffer);
+}
+
+// Keyframe vigente para reconstruir los deltas del backend
+static robocup::SensorStream state_stream;
+
+/**
+ * @brief Mensaje en curso entre eventos MQTT_EVENT_DATA.
+ *
+ * Un estado JSON se decodifica fragmento a fragmento con SensorJsonStream,
+ * sin armar el mensaje completo ni un DOM. Sólo los payloads binarios
+ * (a lo sumo MAX_DELTA_SIZE bytes) se acumulan para el stream de deltas.
+ */
+enum class Incoming : uint8_t { IGNORED, JSON, BINARY };
+
+static constexpr size_t WIRE_BUFFER_SIZE =
+    robocup::WireFormat::MAX_DELTA_SIZE > robocup::WireFormat::MAX_SENSOR_SIZE ?
+    robocup::WireFormat::MAX_DELTA_SIZE : robocup::WireFormat::MAX_SENSOR_SIZE;
+
+static Incoming incoming = Incoming::IGNORED;
+static robocup::SensorJsonStream json_stream;
+static robocup::SensorData json_sensors;
+static uint8_t wire_buffer[WIRE_BUFFER_SIZE];
+static size_t wire_size = 0;
+static bool wire_overflow = false;
+
+/**
+ * @brief Primer fragmento de un mensaje: elige cómo se van a consumir los siguientes.
+ */
+static void begin_message(const esp_mqtt_event_handle_t event) {
+    std::string_view topic(event->topic, event->topic_len);
+    if (topic.find("game/state") == std::string_view::npos) {
+        incoming = Incoming::IGNORED;
+    } else if (event->data_len > 0 &&
+               static_cast<uint8_t>(event->data[0]) == robocup::WireFormat::MAGIC) {
+        incoming = Incoming::BINARY;
+        wire_size = 0;
+        wire_overflow = false;
+    } else {
+        incoming = Incoming::JSON;
+        json_stream.begin(json_sensors);
     }
-    
-    // Sensors
-    cJSON* sensor_obj = cJSON_GetObjectItem(root, "sensors");
-    if (sensor_obj) {
-        // Ball
-        cJSON* ball = cJSON_GetObjectItem(sensor_obj, "ball");
-        if (ball) {
-            cJSON* dist = cJSON_GetObjectItem(ball, "dist");
-            cJSON* angle = cJSON_GetObjectItem(ball, "angle");
-            if (dist && angle) {
-                sensors.ball.distance = (float)dist->valuedouble;
-                sensors.ball.angle = (float)angle->valuedouble;
-                sensors.ball.visible = true;
-            }
-        }
-        
-        // Goal
-        cJSON* goal = cJSON_GetObjectItem(sensor_obj, "goal");
-        if (goal) {
-            cJSON* dist = cJSON_GetObjectItem(goal, "dist");
-            cJSON* angle = cJSON_GetObjectItem(goal, "angle");
-            if (dist && angle) {
-                sensors.goal.distance = (float)dist->valuedouble;
-                sensors.goal.angle = (float)angle->valuedouble;
-                sensors.goal.visible = true;
-            }
+}
+
+static void consume_fragment(const char* data, int size) {
+    if (incoming == Incoming::JSON) {
+        json_stream.feed(data, static_cast<size_t>(size));
+    } else if (incoming == Incoming::BINARY) {
+        if (wire_size + size > sizeof(wire_buffer)) {
+            wire_overflow = true;
+            return;
         }
+        memcpy(wire_buffer + wire_size, data, size);
+        wire_size += size;
     }
-    
-    cJSON_Delete(root);
-    return sensors;
 }
 
-static void publish_action(const robocup::Action& action) {
-    if (!mqtt_client) return;
-    
-    const char* action_names[] = {"none", "dash", "turn", "kick", "catch", "move"};
-    
-    char buffer[128];
-    snprintf(buffer, sizeof(buffer),
-        "{\"action\":\"%s\",\"params\":[%.1f,%.1f]}",
-        action_names[static_cast<int>(action.type)],
-        action.params[0], action.params[1]);
+/**
+ * @brief Último fragmento: arma el StatePacket y lo encola para la tarea del agente.
+ */
+static void finish_message() {
+    // Se llena en el lugar; si el mensaje se descarta el buffer se reutiliza
+    StatePacket& packet = state_mailbox.write_buffer();
+    packet.received_us = esp_timer_get_time();
+    if (incoming == Incoming::BINARY) {
+        binary_peer = true;
+        // Keyframe o delta: el stream devuelve el estado completo
+        size_t state_size = 0;
+        const uint8_t* state = wire_overflow ? nullptr :
+            state_stream.receive(wire_buffer, wire_size, state_size);
+        if (!state) {
+            ESP_LOGW(TAG, "Dropped state (%u bytes, %u dropped)", static_cast<unsigned>(wire_size),
+                     static_cast<unsigned>(state_stream.dropped()));
+            return;
+        }
+        packet.size = static_cast<uint16_t>(state_size);
+        memcpy(packet.data, state, state_size);
+    } else {
+        binary_peer = false;
+        if (!json_stream.finish()) {
+            ESP_LOGW(TAG, "Failed to parse JSON");
+            return;
+        }
+        packet.size = static_cast<uint16_t>(
+            robocup::WireFormat::encode(json_sensors, packet.data, sizeof(packet.data)));
+    }
     
-    esp_mqtt_client_publish(mqtt_client, TOPIC_ACTION, buffer, 0, 1, 0);
-    ESP_LOGD(TAG, "Published: %s", buffer);
+    robocup::SensorDataView sensors;
+    if (!sensors.bind(packet.data, packet.size)) {
+        ESP_LOGW(TAG, "Malformed state (%u bytes)", static_cast<unsigned>(packet.size));
+        return;
+    }
+    if (sensors.status() != robocup::GameStatus::IDLE) {
+        ESP_LOGI(TAG, "Parsed - Status: %d, Role: %d, Ball visible: %d", 
+                 static_cast<int>(sensors.status()),
+                 static_cast<int>(sensors.role()),
+                 sensors.ball().visible);
+    }
+    if (state_mailbox.publish()) {
+        ESP_LOGD(TAG, "Unread state overwritten (%u total)",
+                 static_cast<unsigned>(state_mailbox.overwritten()));
+    }
+    if (agent_task_handle) {
+        xTaskNotifyGive(agent_task_handle);
+    }
 }
 
-// Buffer estático para ensamblar mensajes fragmentados
-static char mqtt_data_buffer[2048] = {0};
-static int mqtt_data_offset = 0;
-static char mqtt_topic_buffer[64] = {0};
-
 static void mqtt_event_handler(void* args, esp_event_base_t base, 
                                int32_t event_id, void* event_data) {
     esp_mqtt_event_handle_t event = (esp_mqtt_event_handle_t)event_data;
@@ -218,59 +276,30 @@ static void mqtt_event_handler(void* args, esp_event_base_t base,
             esp_mqtt_client_subscribe(mqtt_client, TOPIC_STATE, 1);
             esp_mqtt_client_subscribe(mqtt_client, TOPIC_TEAM, 1);
             break;
-            
+        
         case MQTT_EVENT_DISCONNECTED:
             ESP_LOGW(TAG, "MQTT disconnected");
             break;
-            
+        
         case MQTT_EVENT_DATA: {
-            // Verificar si es el inicio de un nuevo mensaje
+            // El topic sólo viene en el primer fragmento de cada mensaje
             if (event->current_data_offset == 0) {
-                // Nuevo mensaje - guardar topic y resetear buffer
-                mqtt_data_offset = 0;
-                memset(mqtt_data_buffer, 0, sizeof(mqtt_data_buffer));
-                memset(mqtt_topic_buffer, 0, sizeof(mqtt_topic_buffer));
-                
-                int topic_len = event->topic_len < 63 ? event->topic_len : 63;
-                memcpy(mqtt_topic_buffer, event->topic, topic_len);
+                begin_message(event);
             }
-            
-            // Copiar fragmento al buffer
-            int copy_len = event->data_len;
-            if (mqtt_data_offset + copy_len >= sizeof(mqtt_data_buffer) - 1) {
-                copy_len = sizeof(mqtt_data_buffer) - 1 - mqtt_data_offset;
-                ESP_LOGW(TAG, "MQTT buffer overflow, truncating");
+            if (incoming == Incoming::IGNORED) {
+                break;
             }
             
-            if (copy_len > 0) {
-                memcpy(mqtt_data_buffer + mqtt_data_offset, event->data, copy_len);
-                mqtt_data_offset += copy_len;
-            }
+            consume_fragment(event->data, event->data_len);
             
-            // Verificar si el mensaje está completo
             bool is_complete = (event->current_data_offset + event->data_len >= event->total_data_len);
-            
             ESP_LOGD(TAG, "MQTT fragment: offset=%d, len=%d, total=%d, complete=%d",
                      event->current_data_offset, event->data_len, 
                      event->total_data_len, is_complete);
             
             if (is_complete) {
-                ESP_LOGI(TAG, "MQTT complete message, topic: %s, total_len: %d", 
-                         mqtt_topic_buffer, mqtt_data_offset);
-                
-                if (strstr(mqtt_topic_buffer, "game/state") != nullptr) {
-                    robocup::SensorData sensors = parse_sensor_json(mqtt_data_buffer);
-                    if (sensors.status != robocup::GameStatus::IDLE) {
-                        ESP_LOGI(TAG, "Parsed - Status: %d, Role: %d, Ball visible: %d", 
-                                 static_cast<int>(sensors.status),
-                                 static_cast<int>(sensors.role),
-                                 sensors.ball.visible);
-                    }
-                    xQueueSend(sensor_queue, &sensors, 0);
-                }
-                
-                // Resetear para siguiente mensaje
-                mqtt_data_offset = 0;
+                finish_message();
+                incoming = Incoming::IGNORED;
             }
             break;
         }
@@ -296,15 +325,68 @@ static void mqtt_init() {
 // Tarea principal del agente
 // =============================================================================
 
+/**
+ * @brief Tiempos del ciclo del agente en µs, reportados cada CYCLE_REPORT_EVERY ciclos.
+ */
+struct CycleStats {
+    uint32_t cycles = 0;
+    uint32_t over_budget = 0;
+    int64_t total_us = 0;
+    int64_t max_us = 0;
+    int64_t localization_us = 0;
+    
+    void add(int64_t cycle_us, int64_t loc_us) {
+        ++cycles;
+        total_us += cycle_us;
+        localization_us += loc_us;
+        if (cycle_us > max_us) max_us = cycle_us;
+        if (cycle_us > CYCLE_BUDGET_US) ++over_budget;
+    }
+    
+    void report_and_reset() {
+        ESP_LOGI(TAG, "Cycle time: avg %lld us (localization %lld us), max %lld us, %u/%u over %d us budget",
+                 static_cast<long long>(total_us / cycles),
+                 static_cast<long long>(localization_us / cycles),
+                 static_cast<long long>(max_us),
+                 static_cast<unsigned>(over_budget), static_cast<unsigned>(cycles), CYCLE_BUDGET_US);
+        *this = CycleStats();
+    }
+};
+
 static void agent_task(void* pvParameters) {
     ESP_LOGI(TAG, "Agent task started");
     
-    robocup::SensorData sensors;
+    robocup::SensorDataView sensors;  // Lee directo del buffer tomado del buzón
+    robocup::Action pending_action;  // Acción enviada desde el último estado recibido
     TickType_t last_send_time = 0;
+    int64_t last_state_us = 0;  // Llegada del estado anterior
+    CycleStats stats;
     
     while (true) {
-        // Esperar datos de sensores del broker
-        if (xQueueReceive(sensor_queue, &sensors, pdMS_TO_TICKS(100)) == pdTRUE) {
+        // Esperar el aviso del handler MQTT; el buzón sólo guarda el estado más nuevo
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(100));
+        const StatePacket* packet = state_mailbox.take();
+        if (packet && sensors.bind(packet->data, packet->size)) {
+            // Dead reckoning con la última acción + corrección con banderas y líneas
+            int64_t loc_start_us = esp_timer_get_time();
+            robocup::FlagInfo flags[robocup::SensorData::MAX_FLAGS];
+            robocup::LineInfo lines[robocup::SensorData::MAX_LINES];
+            uint8_t flag_count = sensors.copy_flags(flags);
+            uint8_t line_count = sensors.copy_lines(lines);
+            pose_tracker.predict(pending_action);
+            pose_tracker.correct(flags, flag_count, lines, line_count);
+            sensors.set_position(pose_tracker.pose());
+            pending_action = robocup::Action::none();
+            
+            // Balón en coordenadas de campo, predicho si no se ve. El backend no
+            // publica todos los ciclos y el buzón pisa estados: avanzar según la llegada
+            robocup::ObjectInfo ball = sensors.ball();
+            uint16_t cycles = robocup::BallTracker::elapsed_cycles(packet->received_us - last_state_us);
+            last_state_us = packet->received_us;
+            ball_tracker.update(ball, sensors.position(), cycles);
+            sensors.set_ball_estimate(ball_tracker.relative_to(sensors.position()));
+            int64_t loc_us = esp_timer_get_time() - loc_start_us;
+            
             // Verificar rate limit (75ms entre comandos)
             TickType_t now = xTaskGetTickCount();
             // TODO: Analizar el uso de VtaskDelay 
@@ -318,11 +400,11 @@ static void agent_task(void* pvParameters) {
             // TODO: Esta logica deberia estar en el game logic, esto viene del platform-pc entonces ajusta alla tambien
             // Si es kick pero la bola está fuera de rango, convertir a dash
             if (action.type == robocup::ActionType::KICK) {
-                if (!sensors.ball.visible || sensors.ball.distance > 0.8f) {
+                if (!ball.visible || ball.distance > 0.8f) {
                     // Convertir kick inválido a dash hacia la bola
                     action.type = robocup::ActionType::DASH;
                     action.params[0] = 80.0f;  // Potencia
-                    action.params[1] = sensors.ball.visible ? sensors.ball.angle : 0;
+                    action.params[1] = ball.visible ? ball.angle : 0;
                 }
             }
             
@@ -330,17 +412,36 @@ static void agent_task(void* pvParameters) {
             if (action.type != robocup::ActionType::NONE) {
                 publish_action(action);
                 last_send_time = now;
+                pending_action = action;
+            }
+            
+            // Tiempo desde que llegó el estado (incluye la espera en el buzón)
+            int64_t cycle_us = esp_timer_get_time() - packet->received_us;
+            stats.add(cycle_us, loc_us);
+            if (cycle_us > CYCLE_BUDGET_US) {
+                ESP_LOGW(TAG, "Cycle over budget: %lld us", static_cast<long long>(cycle_us));
+            }
+            if (stats.cycles >= CYCLE_REPORT_EVERY) {
+                stats.report_and_reset();
             }
             
             // Log de estado
             const char* state_names[] = {"IDLE", "SEARCHING", "APPROACHING", "DRIBBLING",
                                          "SHOOTING", "PASSING", "DEFENDING", "CATCHING"};
-            ESP_LOGI(TAG, "State: %s", state_names[static_cast<int>(game_logic.get_state())]);
+            const robocup::PlayerPosition& pose = sensors.position();
+            // Pose en decímetros enteros: un %f arrastraría el printf de float al binario
+            ESP_LOGI(TAG, "State: %s, pose: (%d, %d) dm %s, flags: %u, lines: %u",
+                     state_names[static_cast<int>(game_logic.get_state())],
+                     static_cast<int>(pose.x * 10.0f), static_cast<int>(pose.y * 10.0f),
+                     pose.valid ? "valid" : "unknown",
+                     static_cast<unsigned>(flag_count), static_cast<unsigned>(line_count));
         }
         
         // Si el juego terminó, resetear
-        if (sensors.status == robocup::GameStatus::FINISHED) {
+        if (sensors.status() == robocup::GameStatus::FINISHED) {
             game_logic.reset();
+            pose_tracker.reset();
+            ball_tracker.reset();
             ESP_LOGI(TAG, "Game finished, agent reset");
         }
     }
@@ -362,9 +463,6 @@ extern "C" void app_main() {
     }
     ESP_ERROR_CHECK(ret);
     
-    // Crear cola para sensores
-    sensor_queue = xQueueCreate(10, sizeof(robocup::SensorData));
-    
     // Inicializar WiFi
     wifi_init();
     
@@ -376,7 +474,7 @@ extern "C" void app_main() {
     mqtt_init();
     
     // Crear tarea del agente
-    xTaskCreate(agent_task, "agent_task", 8192, nullptr, 5, nullptr);
+    xTaskCreate(agent_task, "agent_task", 8192, nullptr, 5, &agent_task_handle);
     
     ESP_LOGI(TAG, "System initialized, agent running");
 }
@@ -0,0 +1,233 @@
+#ifndef ROBOCUP_AGENT_EXECUTOR_H
+#define ROBOCUP_AGENT_EXECUTOR_H
+
+/**
+ * @file agent_executor.h
+ * @brief Pool de hilos con robo de trabajo para decidir muchos agentes por proceso.
+ *
+ * Cada worker tiene su propia cola. Una tarea se encola en el worker
+ * "home" de su agente (affinity % workers), así la GameLogic y los
+ * trackers de ese agente quedan calientes en la caché del mismo núcleo.
+ * Un worker sin trabajo propio roba del final de la cola de otro, de modo
+ * que un agente lento no frena a los demás.
+ *
+ * Contrato:
+ * - A lo sumo una tarea en vuelo por agente: el executor no serializa
+ *   tareas de la misma afinidad (el modo equipo de main_pc.cpp encola una
+ *   por jugador y lote, y espera con wait_idle() antes del lote siguiente).
+ * - Las tareas no deben lanzar excepciones.
+ * - Si las tareas referencian datos del llamador, éste debe esperar con
+ *   wait_idle() antes de liberarlos, también si submit() lanza a mitad de
+ *   un lote (ver IdleGuard).
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace robocup {
+
+/**
+ * @brief Work-stealing thread pool con afinidad por agente.
+ */
+class AgentExecutor {
+public:
+    using Task = std::function<void()>;
+    
+    /**
+     * @param workers Cantidad de hilos (0 = uno)
+     */
+    explicit AgentExecutor(size_t workers)
+        : workers_(workers ? workers : 1)
+        , queued_(0)
+        , pending_(0)
+        , stolen_(0)
+        , stopping_(false)
+    {
+        for (size_t i = 0; i < workers_.size(); ++i) {
+            workers_[i].thread = std::thread([this, i] { work(i); });
+        }
+    }
+    
+    ~AgentExecutor() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stopping_ = true;
+        }
+        for (Worker& w : workers_) {
+            w.wake.notify_one();
+        }
+        for (Worker& w : workers_) {
+            w.thread.join();
+        }
+    }
+    
+    AgentExecutor(const AgentExecutor&) = delete;
+    AgentExecutor& operator=(const AgentExecutor&) = delete;
+    
+    size_t worker_count() const { return workers_.size(); }
+    
+    /**
+     * @brief Encola task en el worker de la afinidad y despierta a quien pueda correrla.
+     *
+     * Se despierta al worker home si está dormido; si está ocupado, a
+     * cualquier otro dormido para que la robe.
+     */
+    void submit(size_t affinity, Task task) {
+        size_t home = affinity % workers_.size();
+        pending_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(workers_[home].mutex);
+            workers_[home].tasks.push_back(std::move(task));
+        }
+        
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        queued_.fetch_add(1, std::memory_order_relaxed);
+        if (!signal(home)) {
+            for (size_t i = 0; i < workers_.size() && !signal(i); ++i) {
+            }
+        }
+    }
+    
+    /**
+     * @brief Bloquea hasta que terminen todas las tareas encoladas.
+     */
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        idle_.wait(lock, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+    }
+    
+    /**
+     * @brief Tareas que corrieron fuera de su worker home.
+     */
+    uint64_t stolen() const { return stolen_.load(std::memory_order_relaxed); }
+
+private:
+    struct Worker {
+        std::thread thread;
+        std::mutex mutex;               // Protege tasks
+        std::deque<Task> tasks;
+        std::condition_variable wake;   // Con sleep_mutex_
+        bool sleeping = false;
+        bool signaled = false;
+    };
+    
+    std::vector<Worker> workers_;
+    std::atomic<size_t> queued_;        // Tareas en alguna cola, todavía sin tomar
+    std::atomic<size_t> pending_;       // Encoladas o corriendo
+    std::atomic<uint64_t> stolen_;
+    
+    std::mutex sleep_mutex_;            // Protege sleeping/signaled/stopping_
+    bool stopping_;
+    
+    std::mutex idle_mutex_;
+    std::condition_variable idle_;
+    
+    /**
+     * @brief Despierta al worker i si está dormido y nadie lo avisó aún (con sleep_mutex_ tomado).
+     */
+    bool signal(size_t i) {
+        Worker& w = workers_[i];
+        if (!w.sleeping || w.signaled) {
+            return false;
+        }
+        w.signaled = true;
+        w.wake.notify_one();
+        return true;
+    }
+    
+    /**
+     * @brief Propia cola por el frente (orden de llegada).
+     */
+    bool pop_own(size_t i, Task& task) {
+        Worker& w = workers_[i];
+        std::lock_guard<std::mutex> lock(w.mutex);
+        if (w.tasks.empty()) {
+            return false;
+        }
+        task = std::move(w.tasks.front());
+        w.tasks.pop_front();
+        return true;
+    }
+    
+    /**
+     * @brief Colas ajenas por el final, empezando por el vecino.
+     */
+    bool steal(size_t i, Task& task) {
+        for (size_t k = 1; k < workers_.size(); ++k) {
+            Worker& victim = workers_[(i + k) % workers_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.back());
+                victim.tasks.pop_back();
+                stolen_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+    
+    void work(size_t i) {
+        Worker& self = workers_[i];
+        while (true) {
+            Task task;
+            if (pop_own(i, task) || steal(i, task)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                task();
+                if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    std::lock_guard<std::mutex> lock(idle_mutex_);
+                    idle_.notify_all();
+                }
+                continue;
+            }
+            
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            if (stopping_) {
+                return;
+            }
+            // submit incrementa queued_ con sleep_mutex_ tomado: si acá es 0,
+            // la próxima tarea va a encontrar a este worker marcado como dormido
+            if (queued_.load(std::memory_order_relaxed) > 0) {
+                continue;
+            }
+            self.sleeping = true;
+            self.wake.wait(lock, [this, &self] { return self.signaled || stopping_; });
+            self.sleeping = false;
+            self.signaled = false;
+        }
+    }
+};
+
+/**
+ * @brief Llama a wait_idle() al salir del scope, por cualquier camino.
+ *
+ * Para lotes cuyas tareas referencian datos del llamador: si submit() lanza
+ * (p. ej. bad_alloc) con tareas ya encoladas, el destructor espera a que
+ * terminen antes de que el llamador libere lo que usan.
+ */
+class IdleGuard {
+public:
+    explicit IdleGuard(AgentExecutor* executor) : executor_(executor) {}
+    ~IdleGuard() {
+        if (executor_) {
+            executor_->wait_idle();
+        }
+    }
+    
+    IdleGuard(const IdleGuard&) = delete;
+    IdleGuard& operator=(const IdleGuard&) = delete;
+
+private:
+    AgentExecutor* executor_;
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_AGENT_EXECUTOR_H
@@ -13,11 +13,26 @@
 #include <atomic>
 #include <chrono>
 #include <csignal>
+#include <cstdlib>
 #include <cstring>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <string_view>
+#include <vector>
 
 #include "game_logic.h"
 #include "messages.h"
 #include "localization.h"
+#include "pose_tracker.h"
+#include "ball_tracker.h"
+#include "sensor_json.h"
+#include "wire_format.h"
+#include "sensor_view.h"
+#include "action_json.h"
+#include "spsc_ring.h"
+#include "agent_executor.h"
+#include "team_router.h"
 
 #if HAS_PAHO_MQTT
 #include <mqtt/async_client.h>
@@ -87,14 +102,70 @@ void run_simple_simulation() {
 // Cliente MQTT completo
 // =============================================================================
 
+/**
+ * @brief Estado propio de cada jugador atendido por el proceso.
+ */
+struct Player {
+    Player(std::string_view id, size_t home_worker)
+        : device_id(id)
+        , action_topic("player/action/" + device_id)
+        , home(home_worker)
+    {
+    }
+    
+    std::string device_id;
+    std::string action_topic;
+    robocup::GameLogic logic;
+    robocup::PoseTracker tracker;
+    robocup::BallTracker ball_tracker;
+    robocup::Action pending_action;  // Acción enviada desde el último estado recibido
+    std::chrono::steady_clock::time_point last_send_time;
+    std::chrono::steady_clock::time_point last_state_time;  // Llegada del estado anterior
+    bool binary_peer = false;        // El último estado llegó en formato binario
+    robocup::SensorStream stream;    // Keyframe vigente para los deltas
+    size_t home;                     // Worker preferido del executor (afinidad)
+    
+    // Latencia llegada -> acción decidida; cada jugador la acumula en su worker
+    uint64_t latency_samples = 0;
+    std::chrono::steady_clock::duration latency_total{};
+    std::chrono::steady_clock::duration latency_max{};
+};
+
+/**
+ * @brief Una conexión MQTT que atiende a uno o varios jugadores.
+ *
+ * Con un device_id se suscribe a game/state/<id>. En modo equipo se
+ * suscribe a game/state/+ y crea un Player (lógica, trackers y stream
+ * propios) la primera vez que ve cada id; las acciones salen por
+ * player/action/<id> sobre la misma conexión. Con un AgentExecutor, los
+ * ciclos de los jugadores de un mismo lote corren en paralelo, cada uno
+ * preferentemente en el worker donde corrió antes.
+ */
 class MQTTAgent {
 public:
-    MQTTAgent(const std::string& broker_address, const std::string& device_id)
-        : client_(broker_address, device_id)
-        , device_id_(device_id)
-        , state_topic_("game/state/" + device_id)
-        , action_topic_("player/action/" + device_id)
+    /**
+     * @param client_id device_id del jugador, o id de la conexión en modo equipo
+     * @param workers Hilos de decisión en modo equipo (0 = en el hilo del consumidor)
+     */
+    MQTTAgent(const std::string& broker_address, const std::string& client_id, bool team, size_t workers)
+        : client_(broker_address, client_id)
+        , state_topic_(team ? std::string(STATE_PREFIX) + "+" : std::string(STATE_PREFIX) + client_id)
+        , router_(STATE_PREFIX, MAX_PLAYERS, [this](std::string_view id, size_t index) {
+            std::cout << "Serving player " << id << "\n";
+            size_t home = executor_ ? index % executor_->worker_count() : 0;
+            return std::make_unique<Player>(id, home);
+        })
     {
+        if (team && workers > 0) {
+            executor_ = std::make_unique<robocup::AgentExecutor>(workers);
+        }
+        router_.reserve(INBOX_SIZE);
+        overflow_.reserve(INBOX_SIZE);
+        overflow_batch_.reserve(INBOX_SIZE);
+        // Sin polling: paho entrega cada mensaje en su hilo y on_message lo pasa al de decisión
+        client_.set_message_callback([this](mqtt::const_message_ptr msg) {
+            on_message(std::move(msg));
+        });
     }
     
     bool connect() {
@@ -109,9 +180,6 @@ public:
             client_.subscribe(state_topic_, 1)->wait();
             std::cout << "Connected and subscribed to " << state_topic_ << "\n";
             
-            // Iniciar el consumidor para poder usar try_consume_message_for
-            client_.start_consuming();
-            
             return true;
         } catch (const mqtt::exception& e) {
             std::cerr << "MQTT connection error: " << e.what() << "\n";
@@ -120,201 +188,312 @@ public:
     }
     
     void run() {
-        using namespace robocup;
-        
-        GameLogic logic;
-        auto last_send_time = std::chrono::steady_clock::now();
-        constexpr auto MIN_SEND_INTERVAL = std::chrono::milliseconds(75);  // 75ms rate limit
-        
         while (running) {
             try {
-                // Esperar mensaje de estado
-                auto msg = client_.try_consume_message_for(std::chrono::milliseconds(50));
-                
-                if (msg) {
-                    // Parsear JSON (simplificado)
-                    std::string payload = msg->get_payload_str();
-                    SensorData sensors = parse_sensors(payload);
-                    
-                    // Verificar rate limit (100ms entre comandos)
-                    auto now = std::chrono::steady_clock::now();
-                    if (now - last_send_time < MIN_SEND_INTERVAL) {
-                        continue;  // Esperar más tiempo antes de enviar
-                    }
-                    
-                    // Decidir acción
-                    Action action = logic.decide_action(sensors);
-                    
-                    // Si es kick pero la bola está fuera de rango, convertir a dash
-                    if (action.type == ActionType::KICK) {
-                        if (!sensors.ball.visible || sensors.ball.distance > 0.8f) {
-                            // Convertir kick inválido a dash hacia la bola
-                            action.type = ActionType::DASH;
-                            action.params[0] = 80.0f;  // Potencia
-                            action.params[1] = sensors.ball.visible ? sensors.ball.angle : 0;
+                // Esperar estados: el callback de paho los deja en inbox_ y despierta este hilo
+                if (!collect_batch()) {
+                    continue;
+                }
+                // Cada jugador decide sólo sobre su estado más nuevo del lote. Los
+                // anteriores se descartan acá, antes de encolar el más nuevo.
+                // Las tareas apuntan al lote del router: el guard espera que
+                // terminen antes de seguir, aunque algo lance a mitad del lote
+                {
+                    robocup::IdleGuard idle(executor_.get());
+                    for (Router::Entry& entry : router_.batch()) {
+                        if (!entry.latest) {
+                            supersede(*entry.agent, *entry.item.msg);
+                        } else if (executor_) {
+                            executor_->submit(entry.agent->home, [this, &entry] {
+                                handle_state_safely(*entry.agent, entry.item);
+                            });
+                        } else {
+                            handle_state(*entry.agent, entry.item);
                         }
                     }
-                    
-                    // Enviar acción
-                    if (action.type != ActionType::NONE) {
-                        std::string action_json = action_to_json(action);
-                        client_.publish(action_topic_, action_json, 1, false);
-                        last_send_time = now;
-                    }
+                }
+                if (processed_ >= next_stats_) {
+                    print_stats();
+                    next_stats_ = processed_ + STATS_INTERVAL;
                 }
             } catch (const std::exception& e) {
                 std::cerr << "Error: " << e.what() << "\n";
             }
         }
         
+        print_stats();
         client_.disconnect()->wait();
     }
     
 private:
+    static constexpr std::string_view STATE_PREFIX = "game/state/";
+    static constexpr size_t MAX_PLAYERS = 1024;  // Tope ante ids espurios en game/state/+
+    static constexpr auto MIN_SEND_INTERVAL = std::chrono::milliseconds(75);  // 75ms rate limit
+    
+    /**
+     * @brief Mensaje recibido por el callback, con su hora de llegada.
+     */
+    struct Received {
+        mqtt::const_message_ptr msg;
+        std::chrono::steady_clock::time_point at;
+    };
+    
+    using Router = robocup::TeamRouter<Player, Received>;
+    
     mqtt::async_client client_;
-    std::string device_id_;
     std::string state_topic_;
-    std::string action_topic_;
+    Router router_;  // Jugadores por id y estados tomados de inbox_ en esta vuelta
+    std::unique_ptr<robocup::AgentExecutor> executor_;  // Sólo en modo equipo
     
-    // Parser JSON simplificado (en producción usar nlohmann/json)
-    robocup::SensorData parse_sensors(const std::string& json) {
-        robocup::SensorData sensors;
-        
-        // Parseo muy básico de status
-        if (json.find("\"PLAYING\"") != std::string::npos || 
-            json.find("\"play_on\"") != std::string::npos) {
-            sensors.status = robocup::GameStatus::PLAYING;
-        } else if (json.find("\"BEFORE_KICK_OFF\"") != std::string::npos ||
-                   json.find("\"before_kick_off\"") != std::string::npos ||
-                   json.find("\"kick_off_l\"") != std::string::npos ||
-                   json.find("\"kick_off_r\"") != std::string::npos) {
-            sensors.status = robocup::GameStatus::BEFORE_KICK_OFF;
-        } else if (json.find("\"FINISHED\"") != std::string::npos) {
-            sensors.status = robocup::GameStatus::FINISHED;
+    // Callback de paho (productor) -> hilo de decisión (consumidor)
+    static constexpr size_t INBOX_SIZE = 1024;  // Un ciclo completo de cientos de jugadores
+    static constexpr auto WAKE_TIMEOUT = std::chrono::milliseconds(100);  // Sólo para ver running
+    robocup::SpscRing<Received, INBOX_SIZE> inbox_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;
+    
+    // Desborde de inbox_: con el ring lleno el callback no puede descartar
+    // (un keyframe binario perdido deja al jugador sin poder reconstruir
+    // deltas), así que sigue en este vector hasta que el consumidor lo vacíe.
+    // Mientras tenga algo, todo lo nuevo va acá para conservar el orden.
+    std::mutex overflow_mutex_;
+    std::vector<Received> overflow_;                // Con overflow_mutex_
+    std::atomic<bool> overflowing_{false};          // overflow_ no está vacío
+    std::vector<Received> overflow_batch_;          // Sólo consumidor
+    std::atomic<uint64_t> overflowed_{0};           // Pasaron por overflow_
+    
+    // Contadores de estados recibidos (los workers del executor también los incrementan)
+    static constexpr uint64_t STATS_INTERVAL = 600;  // ~1 minuto a 10 estados/s
+    std::atomic<uint64_t> processed_{0};   // Decodificados y usados para decidir
+    std::atomic<uint64_t> dropped_{0};     // Mal formados, delta sin su keyframe o jugador no admitido
+    uint64_t superseded_ = 0;  // Descartados sin decodificar: llegó uno más nuevo
+    uint64_t next_stats_ = STATS_INTERVAL;
+    
+    /**
+     * @brief Hilo de paho: encola sin bloquear (salvo con inbox_ lleno) y despierta al hilo de decisión.
+     */
+    void on_message(mqtt::const_message_ptr msg) {
+        Received received{std::move(msg), std::chrono::steady_clock::now()};
+        // Sólo este hilo pone overflowing_ en true: si está en false, el ring va antes que overflow_
+        if (overflowing_.load(std::memory_order_acquire) || !inbox_.push(std::move(received))) {
+            std::lock_guard<std::mutex> lock(overflow_mutex_);
+            overflow_.push_back(std::move(received));
+            overflowing_.store(true, std::memory_order_release);
+            ++overflowed_;
         }
-        
-        // IMPORTANTE: STRIKER_GK_SIM debe ir ANTES de STRIKER porque contiene "STRIKER"
-        if (json.find("\"STRIKER_GK_SIM\"") != std::string::npos) {
-            sensors.role = robocup::PlayerRole::STRIKER_GK_SIM;
-        } else if (json.find("\"STRIKER\"") != std::string::npos) {
-            sensors.role = robocup::PlayerRole::STRIKER;
-        } else if (json.find("\"GOALKEEPER\"") != std::string::npos) {
-            sensors.role = robocup::PlayerRole::GOALKEEPER;
-        } else if (json.find("\"DRIBBLER\"") != std::string::npos) {
-            sensors.role = robocup::PlayerRole::DRIBBLER;
-        } else if (json.find("\"DEFENDER\"") != std::string::npos) {
-            sensors.role = robocup::PlayerRole::DEFENDER;
-        } else if (json.find("\"PASSER\"") != std::string::npos) {
-            sensors.role = robocup::PlayerRole::PASSER;
-        } else if (json.find("\"RECEIVER\"") != std::string::npos) {
-            sensors.role = robocup::PlayerRole::RECEIVER;
+        // Tomar el mutex (vacío) evita perder el aviso si el consumidor está por dormir
+        { std::lock_guard<std::mutex> lock(wake_mutex_); }
+        wake_.notify_one();
+    }
+    
+    /**
+     * @brief Espera hasta WAKE_TIMEOUT y vacía inbox_ (y después su desborde) en el
+     *        lote del router, asignando cada estado a su jugador.
+     * @return false si no llegó nada
+     */
+    bool collect_batch() {
+        router_.clear_batch();
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_.wait_for(lock, WAKE_TIMEOUT, [this] {
+                return !inbox_.empty() || overflowing_.load(std::memory_order_acquire);
+            });
         }
-        
-        // Parsear ball distance/angle
-        size_t ball_pos = json.find("\"ball\"");
-        if (ball_pos != std::string::npos) {
-            size_t dist_pos = json.find("\"dist\"", ball_pos);
-            size_t angle_pos = json.find("\"angle\"", ball_pos);
-            if (dist_pos != std::string::npos && angle_pos != std::string::npos) {
-                sensors.ball.visible = true;
-                // Parseo simplificado - extraer números
-                size_t colon = json.find(":", dist_pos);
-                if (colon != std::string::npos) {
-                    sensors.ball.distance = std::stof(json.substr(colon + 1, 10));
-                }
-                colon = json.find(":", angle_pos);
-                if (colon != std::string::npos) {
-                    sensors.ball.angle = std::stof(json.substr(colon + 1, 10));
-                }
+        // Con overflowing_ en true el productor ya no escribe en el ring: lo
+        // que queda en él es anterior al desborde y se toma primero
+        bool overflowing = overflowing_.load(std::memory_order_acquire);
+        Received received;
+        while (inbox_.pop(received)) {
+            add_to_batch(std::move(received));
+        }
+        if (overflowing) {
+            {
+                std::lock_guard<std::mutex> lock(overflow_mutex_);
+                overflow_batch_.swap(overflow_);
+                overflowing_.store(false, std::memory_order_release);
+            }
+            for (Received& late : overflow_batch_) {
+                add_to_batch(std::move(late));
             }
+            overflow_batch_.clear();
+        }
+        return !router_.batch().empty();
+    }
+    
+    /**
+     * @brief Asigna un estado a su jugador y lo marca como su más nuevo del lote.
+     */
+    void add_to_batch(Received&& received) {
+        const std::string& topic = received.msg->get_topic();
+        robocup::Routed routed = router_.add(topic, std::move(received));
+        if (routed == robocup::Routed::ADDED) {
+            return;
+        }
+        // Sin agregar, received (y su tópico) sigue intacto
+        if (routed == robocup::Routed::TOO_MANY) {
+            std::cerr << "Ignoring " << Router::id_from_topic(STATE_PREFIX, topic)
+                      << ": already serving " << MAX_PLAYERS << " players\n";
         }
+        ++dropped_;
+    }
+    
+    /**
+     * @brief Un ciclo de decisión de un jugador sobre su estado más nuevo.
+     */
+    void handle_state(Player& player, const Received& received) {
+        using namespace robocup;
         
-        // Parsear goal distance/angle
-        size_t goal_pos = json.find("\"goal\"");
-        if (goal_pos != std::string::npos) {
-            size_t dist_pos = json.find("\"dist\"", goal_pos);
-            size_t angle_pos = json.find("\"angle\"", goal_pos);
-            if (dist_pos != std::string::npos && angle_pos != std::string::npos) {
-                sensors.goal.visible = true;
-                size_t colon = json.find(":", dist_pos);
-                if (colon != std::string::npos) {
-                    sensors.goal.distance = std::stof(json.substr(colon + 1, 10));
-                }
-                colon = json.find(":", angle_pos);
-                if (colon != std::string::npos) {
-                    sensors.goal.angle = std::stof(json.substr(colon + 1, 10));
-                }
-            }
+        // Binario: keyframe o delta, reconstruido por el stream y leído por la
+        // vista sin decodificar. JSON: se decodifica en una pasada a un
+        // SensorData y la vista apunta a él
+        const auto& payload = received.msg->get_payload_ref();
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(payload.data());
+        SensorData json_sensors;
+        SensorDataView sensors;
+        player.binary_peer = WireFormat::is_wire(bytes, payload.size());
+        bool decoded;
+        if (player.binary_peer) {
+            size_t state_size = 0;
+            const uint8_t* state = player.stream.receive(bytes, payload.size(), state_size);
+            decoded = state && sensors.bind(state, state_size);
+        } else {
+            decoded = SensorJson::decode(std::string_view(payload.data(), payload.size()), json_sensors);
+        }
+        if (!decoded) {
+            // Incluye deltas recibidos antes de su keyframe
+            std::cerr << "Dropped state payload for " << player.device_id << " ("
+                      << payload.size() << " bytes)\n";
+            ++dropped_;
+            return;
         }
+        if (!player.binary_peer) {
+            sensors.bind(json_sensors);
+        }
+        ++processed_;
         
-        // Parsear flags para triangulación
-        sensors.flag_count = 0;
-        size_t flags_pos = json.find("\"flags\"");
-        if (flags_pos != std::string::npos) {
-            // Buscar cada bandera en el array
-            size_t search_start = flags_pos;
-            while (sensors.flag_count < robocup::SensorData::MAX_FLAGS) {
-                size_t name_pos = json.find("\"name\"", search_start);
-                if (name_pos == std::string::npos || name_pos > json.find("]", flags_pos)) break;
-                
-                // Extraer nombre
-                size_t name_start = json.find("\"", name_pos + 6) + 1;
-                size_t name_end = json.find("\"", name_start);
-                std::string name = json.substr(name_start, name_end - name_start);
-                
-                // Extraer dist y angle
-                size_t dist_pos = json.find("\"dist\"", name_end);
-                size_t angle_pos = json.find("\"angle\"", name_end);
-                
-                if (dist_pos != std::string::npos && angle_pos != std::string::npos) {
-                    robocup::FlagInfo& flag = sensors.flags[sensors.flag_count];
-                    
-                    // Copiar nombre
-                    for (size_t i = 0; i < 15 && i < name.size(); ++i) {
-                        flag.name[i] = name[i];
-                    }
-                    flag.name[std::min(name.size(), (size_t)15)] = '\0';
-                    
-                    size_t colon = json.find(":", dist_pos);
-                    if (colon != std::string::npos) {
-                        flag.distance = std::stof(json.substr(colon + 1, 10));
-                    }
-                    colon = json.find(":", angle_pos);
-                    if (colon != std::string::npos) {
-                        flag.angle = std::stof(json.substr(colon + 1, 10));
-                    }
-                    flag.visible = true;
-                    sensors.flag_count++;
-                }
-                
-                search_start = angle_pos + 1;
+        // Dead reckoning con la última acción + corrección con banderas
+        FlagInfo flags[SensorData::MAX_FLAGS];
+        LineInfo lines[SensorData::MAX_LINES];
+        uint8_t flag_count = sensors.copy_flags(flags);
+        uint8_t line_count = sensors.copy_lines(lines);
+        player.tracker.predict(player.pending_action);
+        player.tracker.correct(flags, flag_count, lines, line_count);
+        sensors.set_position(player.tracker.pose());
+        player.pending_action = Action::none();
+        
+        // Balón en coordenadas de campo, predicho si no se ve. El backend no
+        // publica todos los ciclos: avanzar según el tiempo entre llegadas
+        ObjectInfo ball = sensors.ball();
+        uint16_t cycles = BallTracker::elapsed_cycles(
+            std::chrono::duration_cast<std::chrono::microseconds>(received.at - player.last_state_time).count());
+        player.last_state_time = received.at;
+        player.ball_tracker.update(ball, sensors.position(), cycles);
+        sensors.set_ball_estimate(player.ball_tracker.relative_to(sensors.position()));
+        
+        // Verificar rate limit (75ms entre comandos)
+        auto now = std::chrono::steady_clock::now();
+        if (now - player.last_send_time < MIN_SEND_INTERVAL) {
+            return;  // Esperar más tiempo antes de enviar
+        }
+        
+        // Decidir acción
+        Action action = player.logic.decide_action(sensors);
+        
+        // Si es kick pero la bola está fuera de rango, convertir a dash
+        if (action.type == ActionType::KICK) {
+            if (!ball.visible || ball.distance > 0.8f) {
+                // Convertir kick inválido a dash hacia la bola
+                action.type = ActionType::DASH;
+                action.params[0] = 80.0f;  // Potencia
+                action.params[1] = ball.visible ? ball.angle : 0;
             }
         }
         
-        // Calcular posición usando triangulación si hay suficientes banderas
-        if (sensors.flag_count >= 2) {
-            sensors.position = robocup::Localization::estimate_position(
-                sensors.flags, sensors.flag_count);
+        // Enviar acción
+        if (action.type != ActionType::NONE) {
+            publish_action(player, action);
+            player.last_send_time = now;
+            player.pending_action = action;
         }
         
-        return sensors;
+        auto latency = std::chrono::steady_clock::now() - received.at;
+        ++player.latency_samples;
+        player.latency_total += latency;
+        if (latency > player.latency_max) player.latency_max = latency;
     }
     
-    std::string action_to_json(const robocup::Action& action) {
-        const char* action_names[] = {"none", "dash", "turn", "kick", "catch", "move"};
-        
-        char buffer[128];
-        std::snprintf(buffer, sizeof(buffer),
-            "{\"action\":\"%s\",\"params\":[%.1f,%.1f]}",
-            action_names[static_cast<int>(action.type)],
-            action.params[0], action.params[1]);
+    /**
+     * @brief handle_state para el executor, que no admite tareas que lancen.
+     */
+    void handle_state_safely(Player& player, const Received& received) noexcept {
+        try {
+            handle_state(player, received);
+        } catch (const std::exception& e) {
+            std::cerr << "Error (" << player.device_id << "): " << e.what() << "\n";
+        }
+    }
+    
+    /**
+     * @brief Descarta un estado que quedó viejo sin decodificarlo.
+     *
+     * Un keyframe binario igual pasa por el stream del jugador (sólo se
+     * copia) para que los deltas que lleguen después se puedan reconstruir.
+     */
+    void supersede(Player& player, const mqtt::message& msg) {
+        const auto& payload = msg.get_payload_ref();
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(payload.data());
+        if (robocup::WireFormat::is_wire(bytes, payload.size()) &&
+            robocup::WireFormat::kind(bytes) == robocup::WireKind::SENSOR_DATA) {
+            size_t state_size = 0;
+            player.stream.receive(bytes, payload.size(), state_size);
+        }
+        ++superseded_;
+    }
+    
+    void print_stats() const {
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        std::cout << "Players: " << router_.size() << ", states: " << processed_ << " processed, "
+                  << superseded_ << " superseded, " << dropped_ << " dropped, "
+                  << overflowed_ << " overflowed\n";
         
-        return std::string(buffer);
+        uint64_t samples = 0;
+        std::chrono::steady_clock::duration total{};
+        std::chrono::steady_clock::duration max{};
+        router_.for_each_agent([&](const Player& player) {
+            samples += player.latency_samples;
+            total += player.latency_total;
+            if (player.latency_max > max) max = player.latency_max;
+        });
+        if (samples > 0) {
+            std::cout << "Latency (arrival -> action): avg "
+                      << duration_cast<microseconds>(total).count() / samples
+                      << " us, max " << duration_cast<microseconds>(max).count() << " us\n";
+        }
+        if (executor_) {
+            std::cout << "Executor: " << executor_->worker_count() << " workers, "
+                      << executor_->stolen() << " tasks stolen\n";
+        }
+    }
+    
+    /**
+     * @brief Responde en el mismo formato en que llegó el último estado del jugador.
+     */
+    void publish_action(const Player& player, const robocup::Action& action) {
+        if (player.binary_peer) {
+            uint8_t buffer[robocup::WireFormat::ACTION_SIZE];
+            size_t size = robocup::WireFormat::encode(action, buffer, sizeof(buffer));
+            client_.publish(player.action_topic, buffer, size, 1, false);
+        } else {
+            char buffer[robocup::ActionJson::MAX_SIZE];
+            size_t size = robocup::ActionJson::encode(action, buffer, sizeof(buffer));
+            client_.publish(player.action_topic, buffer, size, 1, false);
+        }
     }
 };
 
-void run_mqtt_agent(const std::string& broker, const std::string& device_id) {
-    MQTTAgent agent(broker, device_id);
+void run_mqtt_agent(const std::string& broker, const std::string& client_id, bool team, size_t workers) {
+    MQTTAgent agent(broker, client_id, team, workers);
     
     if (!agent.connect()) {
         std::cerr << "Failed to connect to MQTT broker\n";
@@ -336,20 +515,30 @@ int main(int argc, char* argv[]) {
     std::cout << "=== RoboCup Agent (PC Platform) ===\n";
     
 #if HAS_PAHO_MQTT
-    std::string broker = "tcp://localhost:1883";
-    std::string device_id = "ESP_01";
-    
-    if (argc > 1) {
-        broker = argv[1];
-    }
-    if (argc > 2) {
-        device_id = argv[2];
+    // agent_pc [--team] [--workers N] [broker] [device_id | client_id]
+    bool team = false;
+    size_t workers = std::thread::hardware_concurrency();
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--team") == 0) {
+            team = true;
+        } else if (std::strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            workers = std::strtoul(argv[++i], nullptr, 10);
+        } else {
+            args.push_back(argv[i]);
+        }
     }
+    std::string broker = args.size() > 0 ? args[0] : "tcp://localhost:1883";
+    std::string client_id = args.size() > 1 ? args[1] : (team ? "TEAM_HOST" : "ESP_01");
     
     std::cout << "MQTT Broker: " << broker << "\n";
-    std::cout << "Device ID: " << device_id << "\n\n";
+    if (team) {
+        std::cout << "Team mode, client ID: " << client_id << ", workers: " << workers << "\n\n";
+    } else {
+        std::cout << "Device ID: " << client_id << "\n\n";
+    }
     
-    run_mqtt_agent(broker, device_id);
+    run_mqtt_agent(broker, client_id, team, workers);
 #else
     std::cout << "Built without MQTT support, running simple simulation\n\n";
     run_simple_simulation();
@@ -0,0 +1,164 @@
+#ifndef ROBOCUP_TEAM_ROUTER_H
+#define ROBOCUP_TEAM_ROUTER_H
+
+/**
+ * @file team_router.h
+ * @brief Reparto de estados por jugador para el modo equipo de main_pc.cpp.
+ *
+ * Una conexión suscrita a game/state/+ recibe los estados de todos los
+ * jugadores mezclados. El router toma el id del tópico, crea el agente la
+ * primera vez que lo ve (hasta un tope, ante ids espurios) y arma el lote
+ * de la vuelta: cada entrada sabe si es el estado más nuevo de su agente
+ * en el lote, para decidir sólo sobre ése y descartar los anteriores.
+ *
+ * No depende de la librería MQTT: Item es lo que el llamador quiera
+ * guardar de cada mensaje.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace robocup {
+
+/**
+ * @brief Resultado de TeamRouter::add.
+ */
+enum class Routed : uint8_t {
+    ADDED,      // En el lote, como estado más nuevo de su agente
+    NOT_STATE,  // El tópico no es <prefijo><id>
+    TOO_MANY    // Id nuevo con el tope de agentes alcanzado
+};
+
+/**
+ * @brief Agentes por id y lote de estados de la vuelta actual.
+ */
+template<typename Agent, typename Item>
+class TeamRouter {
+public:
+    /**
+     * @brief Crea el agente de un id nuevo; index es el orden de llegada (0, 1, ...).
+     */
+    using Factory = std::function<std::unique_ptr<Agent>(std::string_view id, size_t index)>;
+    
+    struct Entry {
+        Item item;
+        Agent* agent;
+        bool latest;  // Ningún estado posterior del mismo agente en el lote
+    };
+    
+    TeamRouter(std::string_view prefix, size_t max_agents, Factory factory)
+        : prefix_(prefix)
+        , max_agents_(max_agents)
+        , factory_(std::move(factory))
+        , generation_(0)
+    {
+    }
+    
+    /**
+     * @brief Id de un tópico <prefijo><id>, o vacío si no tiene esa forma.
+     */
+    static std::string_view id_from_topic(std::string_view prefix, std::string_view topic) {
+        if (topic.size() <= prefix.size() || topic.substr(0, prefix.size()) != prefix) {
+            return std::string_view();
+        }
+        return topic.substr(prefix.size());
+    }
+    
+    /**
+     * @brief Agente del tópico; se crea al ver el id por primera vez.
+     * @return nullptr si el tópico no es de estado o ya hay max_agents
+     */
+    Agent* agent_for(std::string_view topic) {
+        Slot* slot = slot_for(topic);
+        return slot ? slot->agent.get() : nullptr;
+    }
+    
+    /**
+     * @brief Agrega un estado al lote como el más nuevo de su agente.
+     *
+     * La entrada anterior del mismo agente en el lote, si la hay, queda con
+     * latest = false.
+     */
+    Routed add(std::string_view topic, Item&& item) {
+        if (id_from_topic(prefix_, topic).empty()) {
+            return Routed::NOT_STATE;
+        }
+        Slot* slot = slot_for(topic);
+        if (!slot) {
+            return Routed::TOO_MANY;
+        }
+        if (slot->generation == generation_) {
+            batch_[slot->index].latest = false;
+        }
+        slot->generation = generation_;
+        slot->index = batch_.size();
+        batch_.push_back(Entry{std::move(item), slot->agent.get(), true});
+        return Routed::ADDED;
+    }
+    
+    /**
+     * @brief Vacía el lote para la vuelta siguiente (los agentes se conservan).
+     */
+    void clear_batch() {
+        batch_.clear();
+        ++generation_;
+    }
+    
+    void reserve(size_t entries) { batch_.reserve(entries); }
+    
+    std::vector<Entry>& batch() { return batch_; }
+    
+    size_t size() const { return agents_.size(); }
+    size_t max_agents() const { return max_agents_; }
+    
+    /**
+     * @brief f(const Agent&) para cada agente, en orden de id.
+     */
+    template<typename F>
+    void for_each_agent(F&& f) const {
+        for (const auto& entry : agents_) {
+            f(*entry.second.agent);
+        }
+    }
+
+private:
+    struct Slot {
+        std::unique_ptr<Agent> agent;
+        uint64_t generation;  // Lote en que se agregó su última entrada
+        size_t index;         // Esa entrada en batch_
+    };
+    
+    std::string prefix_;
+    size_t max_agents_;
+    Factory factory_;
+    std::map<std::string, Slot, std::less<>> agents_;
+    std::vector<Entry> batch_;
+    uint64_t generation_;
+    
+    Slot* slot_for(std::string_view topic) {
+        std::string_view id = id_from_topic(prefix_, topic);
+        if (id.empty()) {
+            return nullptr;
+        }
+        auto it = agents_.find(id);
+        if (it != agents_.end()) {
+            return &it->second;
+        }
+        if (agents_.size() >= max_agents_) {
+            return nullptr;
+        }
+        Slot slot{factory_(id, agents_.size()), UINT64_MAX, 0};
+        return &agents_.emplace(std::string(id), std::move(slot)).first->second;
+    }
+};
+
+} // namespace robocup
+
+#endif // ROBOCUP_TEAM_ROUTER_H
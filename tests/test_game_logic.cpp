@@ -324,3 +324,1743 @@ TEST(LocalizationTest, StrikerUsesTriangulationWhenGoalNotVisible) {
     // El ángulo debe ser cercano a 0 (hacia el arco que está adelante)
     EXPECT_NEAR(action.params[1], 0.0f, 15.0f);
 }
+
+// =============================================================================
+// Tests de tabla de banderas (hash perfecto)
+// =============================================================================
+
+#include "field_flags.h"
+
+TEST(FieldFlagsTest, EveryFlagResolvesToItsOwnEntry) {
+    for (uint8_t i = 0; i < FieldFlags::COUNT; ++i) {
+        const FieldFlag& flag = FieldFlags::get(static_cast<FlagId>(i));
+        EXPECT_EQ(static_cast<uint8_t>(FieldFlags::find(flag.name)), i) << flag.name;
+    }
+}
+
+TEST(FieldFlagsTest, ResolvesKnownPositions) {
+    EXPECT_EQ(FieldFlags::find("f c"), FlagId::F_C);
+    EXPECT_EQ(FieldFlags::find("g r"), FlagId::G_R);
+    
+    const FieldFlag& center = FieldFlags::get(FieldFlags::find("f c"));
+    EXPECT_FLOAT_EQ(center.x, 0.0f);
+    EXPECT_FLOAT_EQ(center.y, 0.0f);
+    
+    const FieldFlag& side = FieldFlags::get(FieldFlags::find("f b r 40"));
+    EXPECT_FLOAT_EQ(side.x, 40.0f);
+    EXPECT_FLOAT_EQ(side.y, -39.0f);
+    
+    const FieldFlag& back = FieldFlags::get(FieldFlags::find("f l t 20"));
+    EXPECT_FLOAT_EQ(back.x, -57.5f);
+    EXPECT_FLOAT_EQ(back.y, 20.0f);
+}
+
+TEST(FieldFlagsTest, RejectsUnknownNames) {
+    EXPECT_EQ(FieldFlags::find(""), FlagId::UNKNOWN);
+    EXPECT_EQ(FieldFlags::find("f t l 60"), FlagId::UNKNOWN);
+    EXPECT_EQ(FieldFlags::find("f c "), FlagId::UNKNOWN);
+    EXPECT_EQ(FieldFlags::find("b"), FlagId::UNKNOWN);
+}
+
+TEST(FieldFlagsTest, ResolvesNamesInsideLargerBuffers) {
+    const char* json = "\"name\": \"f p r c\", \"dist\": 3.0";
+    EXPECT_EQ(FieldFlags::find(json + 9, 7), FlagId::F_P_R_C);
+    EXPECT_EQ(FieldFlags::find(json + 9, 5), FlagId::UNKNOWN);  // "f p r"
+}
+
+TEST(FieldFlagsTest, FlagInfoResolvesNameOnConstruction) {
+    FlagInfo known("f t r 30", 12.0f, -5.0f);
+    FlagInfo unknown("x y z", 12.0f, -5.0f);
+    
+    EXPECT_EQ(known.id, FlagId::F_T_R_30);
+    EXPECT_EQ(unknown.id, FlagId::UNKNOWN);
+}
+
+TEST(LocalizationTest, EstimatesPositionFromTableFlags) {
+    // Jugador en (0, 0) mirando hacia +X: "f c t" a 34m con ángulo 90, "f r 0" a 57.5m con ángulo 0
+    FlagInfo flags[2];
+    flags[0] = FlagInfo("f r 0", 57.5f, 0.0f);
+    flags[1] = FlagInfo("f c t", 34.0f, 90.0f);
+    
+    PlayerPosition pos = Localization::estimate_position(flags, 2);
+    
+    ASSERT_TRUE(pos.valid);
+    EXPECT_NEAR(pos.x, 0.0f, 0.5f);
+    EXPECT_NEAR(pos.y, 0.0f, 0.5f);
+    EXPECT_NEAR(pos.heading, 0.0f, 1.0f);
+}
+
+// =============================================================================
+// Tests de multilateración por mínimos cuadrados
+// =============================================================================
+
+namespace {
+
+// Genera la observación exacta de una bandera desde una pose conocida
+FlagInfo observe(FlagId id, float px, float py, float heading, float dist_error = 0.0f) {
+    const FieldFlag& flag = FieldFlags::get(id);
+    float dx = flag.x - px;
+    float dy = flag.y - py;
+    float angle = std::atan2(dy, dx) * 180.0f / 3.14159265f - heading;
+    while (angle > 180.0f) angle -= 360.0f;
+    while (angle < -180.0f) angle += 360.0f;
+    return FlagInfo(id, std::sqrt(dx * dx + dy * dy) + dist_error, angle);
+}
+
+} // namespace
+
+TEST(LocalizationTest, LeastSquaresRecoversPoseFromManyFlags) {
+    FlagInfo flags[5] = {
+        observe(FlagId::F_P_R_T, 10.0f, -5.0f, 30.0f),
+        observe(FlagId::G_R, 10.0f, -5.0f, 30.0f),
+        observe(FlagId::F_T_R_20, 10.0f, -5.0f, 30.0f),
+        observe(FlagId::F_C, 10.0f, -5.0f, 30.0f),
+        observe(FlagId::F_B_R_30, 10.0f, -5.0f, 30.0f),
+    };
+    
+    PositionFix fix = Localization::estimate_fix(flags, 5);
+    
+    ASSERT_TRUE(fix.position.valid);
+    EXPECT_EQ(fix.flags_used, 5);
+    EXPECT_NEAR(fix.position.x, 10.0f, 0.05f);
+    EXPECT_NEAR(fix.position.y, -5.0f, 0.05f);
+    EXPECT_NEAR(fix.position.heading, 30.0f, 0.5f);
+    EXPECT_LT(fix.residual, 0.05f);
+}
+
+TEST(LocalizationTest, LeastSquaresSpreadsErrorOfOneNoisyFlag) {
+    // La segunda bandera lleva error; antes sólo se usaba el primer par
+    FlagInfo flags[6] = {
+        observe(FlagId::F_T_L_10, -20.0f, 10.0f, 0.0f),
+        observe(FlagId::F_L_T_10, -20.0f, 10.0f, 0.0f, 2.0f),
+        observe(FlagId::F_C, -20.0f, 10.0f, 0.0f),
+        observe(FlagId::F_P_L_T, -20.0f, 10.0f, 0.0f),
+        observe(FlagId::F_B_L_20, -20.0f, 10.0f, 0.0f),
+        observe(FlagId::F_T_L_40, -20.0f, 10.0f, 0.0f),
+    };
+    
+    PositionFix pair_fix = Localization::estimate_fix(flags, 2);
+    PositionFix fix = Localization::estimate_fix(flags, 6);
+    
+    ASSERT_TRUE(pair_fix.position.valid);
+    ASSERT_TRUE(fix.position.valid);
+    float pair_err = std::hypot(pair_fix.position.x + 20.0f, pair_fix.position.y - 10.0f);
+    float err = std::hypot(fix.position.x + 20.0f, fix.position.y - 10.0f);
+    EXPECT_LT(err, 0.5f * pair_err);
+    EXPECT_GT(fix.residual, 0.1f);  // El residuo refleja la inconsistencia
+}
+
+TEST(LocalizationTest, CollinearFlagsFallBackToIntersection) {
+    // Todas las banderas sobre la banda superior: sistema lineal degenerado
+    FlagInfo flags[3] = {
+        observe(FlagId::F_T_L_10, 5.0f, 20.0f, 90.0f),
+        observe(FlagId::F_T_0, 5.0f, 20.0f, 90.0f),
+        observe(FlagId::F_T_R_20, 5.0f, 20.0f, 90.0f),
+    };
+    
+    PositionFix fix = Localization::estimate_fix(flags, 3);
+    
+    ASSERT_TRUE(fix.position.valid);
+    EXPECT_NEAR(fix.position.x, 5.0f, 0.1f);
+    EXPECT_NEAR(fix.position.y, 20.0f, 0.1f);
+    EXPECT_NEAR(fix.position.heading, 90.0f, 0.5f);
+}
+
+// =============================================================================
+// Tests de RANSAC
+// =============================================================================
+
+TEST(LocalizationTest, RansacRejectsGrossOutlier) {
+    // La primera bandera llega con 15m de error (p. ej. cuantización o ruido)
+    FlagInfo flags[6] = {
+        observe(FlagId::F_T_R_10, 15.0f, 5.0f, -45.0f, 15.0f),
+        observe(FlagId::F_C, 15.0f, 5.0f, -45.0f),
+        observe(FlagId::F_P_R_B, 15.0f, 5.0f, -45.0f),
+        observe(FlagId::G_R, 15.0f, 5.0f, -45.0f),
+        observe(FlagId::F_B_R_20, 15.0f, 5.0f, -45.0f),
+        observe(FlagId::F_R_B_10, 15.0f, 5.0f, -45.0f),
+    };
+    
+    PositionFix ls = Localization::estimate_fix(flags, 6);
+    PositionFix ransac = Localization::estimate_fix_ransac(flags, 6);
+    
+    ASSERT_TRUE(ransac.position.valid);
+    EXPECT_EQ(ransac.flags_used, 5);
+    EXPECT_NEAR(ransac.position.x, 15.0f, 0.05f);
+    EXPECT_NEAR(ransac.position.y, 5.0f, 0.05f);
+    EXPECT_NEAR(ransac.position.heading, -45.0f, 0.5f);
+    EXPECT_LT(ransac.residual, ls.residual);
+}
+
+TEST(LocalizationTest, RansacSampledModeIsBoundedAndDeterministic) {
+    FlagInfo flags[SensorData::MAX_FLAGS];
+    const FlagId ids[SensorData::MAX_FLAGS] = {
+        FlagId::F_C, FlagId::F_T_0, FlagId::F_B_0, FlagId::F_T_L_20, FlagId::F_B_L_20,
+        FlagId::F_P_L_T, FlagId::F_P_L_B, FlagId::G_L, FlagId::F_L_0, FlagId::F_T_R_20,
+    };
+    for (uint8_t i = 0; i < SensorData::MAX_FLAGS; ++i) {
+        flags[i] = observe(ids[i], -25.0f, -3.0f, 120.0f, i == 3 ? -12.0f : 0.0f);
+    }
+    
+    RansacConfig config;
+    config.max_iterations = 8;  // 45 pares posibles: modo muestreado
+    PositionFix a = Localization::estimate_fix_ransac(flags, SensorData::MAX_FLAGS, config);
+    PositionFix b = Localization::estimate_fix_ransac(flags, SensorData::MAX_FLAGS, config);
+    
+    ASSERT_TRUE(a.position.valid);
+    EXPECT_EQ(a.flags_used, SensorData::MAX_FLAGS - 1);
+    EXPECT_NEAR(a.position.x, -25.0f, 0.05f);
+    EXPECT_NEAR(a.position.y, -3.0f, 0.05f);
+    EXPECT_FLOAT_EQ(a.position.x, b.position.x);
+    EXPECT_FLOAT_EQ(a.position.y, b.position.y);
+}
+
+TEST(LocalizationTest, RansacWithTwoFlagsMatchesLeastSquares) {
+    FlagInfo flags[2] = {
+        observe(FlagId::F_C, 10.0f, 10.0f, 0.0f),
+        observe(FlagId::F_T_R_30, 10.0f, 10.0f, 0.0f),
+    };
+    
+    PositionFix ls = Localization::estimate_fix(flags, 2);
+    PositionFix ransac = Localization::estimate_fix_ransac(flags, 2);
+    
+    EXPECT_EQ(ransac.position.valid, ls.position.valid);
+    EXPECT_FLOAT_EQ(ransac.position.x, ls.position.x);
+    EXPECT_FLOAT_EQ(ransac.position.y, ls.position.y);
+}
+
+TEST(LocalizationTest, IncrementalReusesConsistentPreviousPose) {
+    FlagInfo flags[5] = {
+        observe(FlagId::F_P_R_T, 10.0f, -5.0f, 30.0f, 0.1f),
+        observe(FlagId::G_R, 10.0f, -5.0f, 30.0f),
+        observe(FlagId::F_T_R_20, 10.0f, -5.0f, 30.0f, -0.1f),
+        observe(FlagId::F_C, 10.0f, -5.0f, 30.0f),
+        observe(FlagId::F_B_R_30, 10.0f, -5.0f, 30.0f),
+    };
+    WarmStartStats stats;
+    
+    // Pose del ciclo anterior: ~0.8 m atrás y otro heading
+    PositionFix fix = Localization::estimate_fix_incremental(flags, 5, PlayerPosition(9.4f, -5.5f, 0.0f), stats);
+    PositionFix full = Localization::estimate_fix(flags, 5);
+    
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 0u);
+    ASSERT_TRUE(fix.position.valid);
+    EXPECT_NEAR(fix.position.x, full.position.x, 0.02f);
+    EXPECT_NEAR(fix.position.y, full.position.y, 0.02f);
+    EXPECT_NEAR(fix.position.heading, 30.0f, 0.5f);
+}
+
+TEST(LocalizationTest, IncrementalFallsBackWhenPreviousPoseIsStale) {
+    FlagInfo flags[4];
+    flags[0] = observe(FlagId::F_P_R_T, 10.0f, -5.0f, 30.0f);
+    flags[1] = observe(FlagId::G_R, 10.0f, -5.0f, 30.0f);
+    flags[2] = observe(FlagId::F_T_R_20, 10.0f, -5.0f, 30.0f);
+    flags[3] = observe(FlagId::F_C, 10.0f, -5.0f, 30.0f);
+    WarmStartStats stats;
+    
+    PositionFix far = Localization::estimate_fix_incremental(flags, 4, PlayerPosition(-30.0f, 20.0f, 0.0f), stats);
+    PositionFix none = Localization::estimate_fix_incremental(flags, 4, PlayerPosition(), stats);
+    
+    EXPECT_EQ(stats.hits, 0u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_FLOAT_EQ(stats.hit_rate(), 0.0f);
+    EXPECT_NEAR(far.position.x, 10.0f, 0.05f);
+    EXPECT_NEAR(far.position.y, -5.0f, 0.05f);
+    EXPECT_NEAR(none.position.x, far.position.x, 1e-4f);
+}
+
+TEST(LocalizationTest, IncrementalPicksIntersectionNearPreviousPose) {
+    // "f c" y "f p r c" están sobre y=0: la solución desde cero toma la
+    // primera intersección; el arranque en caliente, la cercana a la anterior.
+    for (float true_y : {8.0f, -8.0f}) {
+        FlagInfo flags[2] = {
+            observe(FlagId::F_C, 15.0f, true_y, 30.0f),
+            observe(FlagId::F_P_R_C, 15.0f, true_y, 30.0f),
+        };
+        WarmStartStats stats;
+        PositionFix fix = Localization::estimate_fix_incremental(
+            flags, 2, PlayerPosition(14.5f, true_y * 0.9f, 30.0f), stats);
+        
+        EXPECT_EQ(stats.hits, 1u) << "y=" << true_y;
+        EXPECT_NEAR(fix.position.x, 15.0f, 0.05f) << "y=" << true_y;
+        EXPECT_NEAR(fix.position.y, true_y, 0.05f) << "y=" << true_y;
+    }
+}
+
+// =============================================================================
+// Tests de líneas de borde
+// =============================================================================
+
+namespace {
+
+// Genera la observación exacta de una línea desde una pose que mira hacia ella
+LineInfo observe_line(LineId id, float px, float py, float heading) {
+    const FieldLine& line = FieldLines::get(id);
+    float nx = std::round(std::cos(line.normal * 3.14159265f / 180.0f));
+    float ny = std::round(std::sin(line.normal * 3.14159265f / 180.0f));
+    float perpendicular = line.offset - (nx * px + ny * py);
+    
+    float theta = line.direction - heading;
+    while (theta > 90.0f) theta -= 180.0f;
+    while (theta <= -90.0f) theta += 180.0f;
+    float dist = perpendicular / std::fabs(std::sin(theta * 3.14159265f / 180.0f));
+    return LineInfo(id, dist, theta);
+}
+
+} // namespace
+
+TEST(FieldLinesTest, ResolvesLineNames) {
+    EXPECT_EQ(FieldLines::find("l t"), LineId::L_T);
+    EXPECT_EQ(FieldLines::find("l r"), LineId::L_R);
+    EXPECT_EQ(FieldLines::find("l x"), LineId::UNKNOWN);
+    EXPECT_EQ(FieldLines::find("l rr"), LineId::UNKNOWN);
+    EXPECT_EQ(FieldLines::find("l b)", 3), LineId::L_B);
+    EXPECT_EQ(LineInfo("l l", 10.0f, 45.0f).id, LineId::L_L);
+}
+
+TEST(LocalizationTest, LineHeadingMatchesTruthInEveryDirection) {
+    const LineId ids[] = {LineId::L_T, LineId::L_B, LineId::L_L, LineId::L_R};
+    for (float heading = -175.0f; heading < 180.0f; heading += 25.0f) {
+        // La línea hacia la que mira más de frente
+        LineId facing = LineId::L_R;
+        float best = -2.0f;
+        for (LineId id : ids) {
+            float c = std::cos((heading - FieldLines::get(id).normal) * 3.14159265f / 180.0f);
+            if (c > best) {
+                best = c;
+                facing = id;
+            }
+        }
+        LineInfo line = observe_line(facing, 10.0f, -5.0f, heading);
+        
+        float estimated = 0;
+        ASSERT_TRUE(Localization::heading_from_lines(&line, 1, estimated));
+        EXPECT_NEAR(Localization::normalize_angle(estimated - heading), 0.0f, 0.05f) << "heading=" << heading;
+    }
+    
+    float unused;
+    EXPECT_FALSE(Localization::heading_from_lines(nullptr, 0, unused));
+}
+
+TEST(LocalizationTest, SingleFlagWithLineGivesPose) {
+    FlagInfo flag = observe(FlagId::F_T_L_10, -20.0f, 12.0f, 60.0f);
+    LineInfo line = observe_line(LineId::L_T, -20.0f, 12.0f, 60.0f);
+    
+    EXPECT_FALSE(Localization::estimate_fix(&flag, 1).position.valid);
+    EXPECT_FALSE(Localization::estimate_fix(&flag, 1, &line, 1, HeadingSource::FLAGS).position.valid);
+    
+    PositionFix fix = Localization::estimate_fix(&flag, 1, &line, 1);
+    ASSERT_TRUE(fix.position.valid);
+    EXPECT_EQ(fix.flags_used, 1);
+    EXPECT_NEAR(fix.position.x, -20.0f, 0.05f);
+    EXPECT_NEAR(fix.position.y, 12.0f, 0.05f);
+    EXPECT_NEAR(fix.position.heading, 60.0f, 0.05f);
+}
+
+TEST(LocalizationTest, CornerLinesGivePoseWithoutFlags) {
+    LineInfo lines[2] = {
+        observe_line(LineId::L_R, 40.0f, 25.0f, 45.0f),
+        observe_line(LineId::L_T, 40.0f, 25.0f, 45.0f),
+    };
+    
+    PositionFix fix = Localization::estimate_fix(nullptr, 0, lines, 2);
+    ASSERT_TRUE(fix.position.valid);
+    EXPECT_NEAR(fix.position.x, 40.0f, 0.05f);
+    EXPECT_NEAR(fix.position.y, 25.0f, 0.05f);
+    EXPECT_NEAR(fix.position.heading, 45.0f, 0.05f);
+    
+    // Una sola línea fija el heading pero no la posición
+    EXPECT_FALSE(Localization::estimate_fix(nullptr, 0, lines, 1).position.valid);
+}
+
+TEST(LocalizationTest, LineHeadingResolvesTwoFlagMirror) {
+    // Mismo par que IncrementalPicksIntersectionNearPreviousPose, sin pose anterior
+    for (float true_y : {8.0f, -8.0f}) {
+        FlagInfo flags[2] = {
+            observe(FlagId::F_C, 15.0f, true_y, 30.0f),
+            observe(FlagId::F_P_R_C, 15.0f, true_y, 30.0f),
+        };
+        LineInfo line = observe_line(LineId::L_R, 15.0f, true_y, 30.0f);
+        
+        PositionFix fix = Localization::estimate_fix(flags, 2, &line, 1);
+        ASSERT_TRUE(fix.position.valid);
+        EXPECT_NEAR(fix.position.x, 15.0f, 0.05f) << "y=" << true_y;
+        EXPECT_NEAR(fix.position.y, true_y, 0.05f) << "y=" << true_y;
+    }
+}
+
+// =============================================================================
+// Tests de PoseTracker (EKF)
+// =============================================================================
+
+#include "pose_tracker.h"
+
+namespace {
+
+// Banderas de referencia alrededor del centro del campo
+uint8_t observe_center_flags(FlagInfo* flags, float x, float y, float heading) {
+    flags[0] = observe(FlagId::F_C, x, y, heading);
+    flags[1] = observe(FlagId::F_T_0, x, y, heading);
+    flags[2] = observe(FlagId::F_P_R_T, x, y, heading);
+    flags[3] = observe(FlagId::F_B_L_10, x, y, heading);
+    return 4;
+}
+
+} // namespace
+
+TEST(PoseTrackerTest, InvalidUntilInitializedWithFlags) {
+    PoseTracker tracker;
+    FlagInfo flags[4];
+    
+    tracker.predict(Action::dash(100, 0));
+    EXPECT_FALSE(tracker.pose().valid);
+    
+    uint8_t n = observe_center_flags(flags, -10.0f, 5.0f, 0.0f);
+    EXPECT_GT(tracker.correct(flags, n), 0);
+    
+    PlayerPosition pos = tracker.pose();
+    ASSERT_TRUE(pos.valid);
+    EXPECT_NEAR(pos.x, -10.0f, 0.1f);
+    EXPECT_NEAR(pos.y, 5.0f, 0.1f);
+}
+
+TEST(PoseTrackerTest, DeadReckoningFollowsDashAndTurn) {
+    PoseTracker tracker;
+    FlagInfo flags[4];
+    tracker.correct(flags, observe_center_flags(flags, 5.0f, 3.0f, 0.0f));
+    
+    // dash 100: aceleración 0.6 m/ciclo, luego decae con 0.4
+    tracker.predict(Action::dash(100, 0));
+    EXPECT_NEAR(tracker.pose().x, 5.6f, 0.05f);
+    tracker.predict(Action::none());
+    EXPECT_NEAR(tracker.pose().x, 5.6f + 0.24f, 0.05f);
+    
+    // Sin velocidad apreciable el giro es casi completo
+    for (int i = 0; i < 10; ++i) tracker.predict(Action::none());
+    tracker.predict(Action::turn(60));
+    EXPECT_NEAR(tracker.pose().heading, 60.0f, 1.0f);
+    EXPECT_TRUE(tracker.pose().valid);
+}
+
+TEST(PoseTrackerTest, CovarianceGrowsWithoutFlagsAndShrinksWithThem) {
+    PoseTracker tracker;
+    FlagInfo flags[4];
+    tracker.correct(flags, observe_center_flags(flags, 20.0f, -10.0f, 45.0f));
+    float initial = tracker.covariance(0, 0);
+    
+    for (int i = 0; i < 5; ++i) tracker.predict(Action::none());
+    EXPECT_GT(tracker.covariance(0, 0), initial);
+    EXPECT_TRUE(tracker.pose().valid);  // Sigue válida en ciclos sin banderas
+    
+    float before = tracker.covariance(0, 0);
+    tracker.correct(flags, observe_center_flags(flags, 20.0f, -10.0f, 45.0f));
+    EXPECT_LT(tracker.covariance(0, 0), before);
+}
+
+TEST(PoseTrackerTest, CorrectionPullsDriftBackToFlags) {
+    PoseTracker tracker;
+    FlagInfo flags[4];
+    tracker.correct(flags, observe_center_flags(flags, -5.0f, 3.0f, 0.0f));
+    
+    // El jugador predice un dash pero en realidad quedó quieto (p. ej. sin stamina)
+    tracker.predict(Action::dash(100, 0));
+    tracker.correct(flags, observe_center_flags(flags, -5.0f, 3.0f, 0.0f));
+    
+    EXPECT_NEAR(tracker.pose().x, -5.0f, 0.2f);
+    EXPECT_NEAR(tracker.pose().heading, 0.0f, 1.0f);
+}
+
+TEST(PoseTrackerTest, LinesInitializeAndCorrectHeading) {
+    PoseTracker tracker;
+    FlagInfo flag = observe(FlagId::F_T_L_10, -20.0f, 12.0f, 60.0f);
+    LineInfo line = observe_line(LineId::L_T, -20.0f, 12.0f, 60.0f);
+    
+    EXPECT_EQ(tracker.correct(&flag, 1), 0);
+    EXPECT_GT(tracker.correct(&flag, 1, &line, 1), 0);
+    EXPECT_NEAR(tracker.pose().x, -20.0f, 0.1f);
+    EXPECT_NEAR(tracker.pose().heading, 60.0f, 0.1f);
+    
+    // Giro predicho que no ocurrió: la línea sola devuelve el heading
+    tracker.predict(Action::turn(10));
+    EXPECT_GT(tracker.correct(nullptr, 0, &line, 1), 0);
+    EXPECT_NEAR(tracker.pose().heading, 60.0f, 2.0f);
+    EXPECT_NEAR(tracker.pose().y, 12.0f, 0.2f);
+}
+
+TEST(PoseTrackerTest, BecomesInvalidAfterLongBlindStretch) {
+    PoseTracker tracker;
+    FlagInfo flags[4];
+    tracker.correct(flags, observe_center_flags(flags, -5.0f, 3.0f, 0.0f));
+    
+    for (int i = 0; i < 200; ++i) tracker.predict(Action::dash(100, 0));
+    
+    EXPECT_FALSE(tracker.pose().valid);
+}
+
+TEST(PoseTrackerTest, ReinitializesAfterTeleport) {
+    PoseTracker tracker;
+    FlagInfo flags[4];
+    for (int i = 0; i < 3; ++i) {
+        tracker.predict(Action::none());
+        tracker.correct(flags, observe_center_flags(flags, -10.0f, 5.0f, 0.0f));
+    }
+    
+    // El servidor mueve al jugador: casi todas las banderas caen fuera de la puerta
+    for (int i = 0; i < PoseTrackerConfig::MAX_REJECTED_CYCLES; ++i) {
+        tracker.predict(Action::none());
+        EXPECT_LT(tracker.correct(flags, observe_center_flags(flags, 20.0f, -15.0f, 90.0f)), 4);
+    }
+    
+    tracker.predict(Action::none());
+    EXPECT_GT(tracker.correct(flags, observe_center_flags(flags, 20.0f, -15.0f, 90.0f)), 0);
+    PlayerPosition pos = tracker.pose();
+    ASSERT_TRUE(pos.valid);
+    EXPECT_NEAR(pos.x, 20.0f, 0.2f);
+    EXPECT_NEAR(pos.y, -15.0f, 0.2f);
+    EXPECT_NEAR(pos.heading, 90.0f, 1.0f);
+}
+
+TEST(PoseTrackerTest, ReinitializesWhenPoseInvalid) {
+    PoseTracker tracker;
+    FlagInfo flags[4];
+    tracker.correct(flags, observe_center_flags(flags, -5.0f, 3.0f, 0.0f));
+    for (int i = 0; i < 200; ++i) tracker.predict(Action::dash(100, 0));
+    ASSERT_FALSE(tracker.pose().valid);
+    
+    EXPECT_GT(tracker.correct(flags, observe_center_flags(flags, 30.0f, 10.0f, 0.0f)), 0);
+    ASSERT_TRUE(tracker.pose().valid);
+    EXPECT_NEAR(tracker.pose().x, 30.0f, 0.2f);
+    EXPECT_NEAR(tracker.pose().y, 10.0f, 0.2f);
+}
+
+// =============================================================================
+// Tests de ParticleLocalizer (Monte Carlo)
+// =============================================================================
+
+#include "particle_filter.h"
+
+TEST(ParticleLocalizerTest, ConvergesToTruePose) {
+    ParticleLocalizer<256> pf;
+    FlagInfo flags[4];
+    uint8_t n = observe_center_flags(flags, 12.0f, -8.0f, 150.0f);
+    
+    for (int i = 0; i < 3; ++i) {
+        pf.update(flags, n);
+        pf.predict(Action::none());
+    }
+    pf.update(flags, n);
+    PlayerPosition pos = pf.estimate();
+    
+    ASSERT_TRUE(pos.valid);
+    EXPECT_NEAR(pos.x, 12.0f, 0.5f);
+    EXPECT_NEAR(pos.y, -8.0f, 0.5f);
+    EXPECT_NEAR(pos.heading, 150.0f, 3.0f);
+}
+
+TEST(ParticleLocalizerTest, ResolvesMirrorAmbiguityWithTwoFlags) {
+    // "f c" y "f p r c" están sobre y=0: las dos intersecciones (x, ±y) caen
+    // dentro del campo y sólo los ángulos distinguen cuál es la real.
+    for (float true_y : {8.0f, -8.0f}) {
+        ParticleLocalizer<256> pf;
+        FlagInfo flags[2] = {
+            observe(FlagId::F_C, 15.0f, true_y, 30.0f),
+            observe(FlagId::F_P_R_C, 15.0f, true_y, 30.0f),
+        };
+        
+        pf.update(flags, 2);
+        pf.predict(Action::none());
+        pf.update(flags, 2);
+        PlayerPosition pos = pf.estimate();
+        
+        ASSERT_TRUE(pos.valid) << "y=" << true_y;
+        EXPECT_NEAR(pos.x, 15.0f, 1.0f) << "y=" << true_y;
+        EXPECT_NEAR(pos.y, true_y, 1.0f) << "y=" << true_y;
+    }
+}
+
+TEST(ParticleLocalizerTest, TracksMotionAndIsDeterministic) {
+    ParticleLocalizer<64> a(1234);
+    ParticleLocalizer<64> b(1234);
+    FlagInfo flags[4];
+    uint8_t n = observe_center_flags(flags, -30.0f, 10.0f, 0.0f);
+    
+    a.update(flags, n);
+    b.update(flags, n);
+    a.predict(Action::dash(100, 0));
+    b.predict(Action::dash(100, 0));
+    
+    n = observe_center_flags(flags, -29.4f, 10.0f, 0.0f);
+    a.update(flags, n);
+    b.update(flags, n);
+    
+    PlayerPosition pa = a.estimate();
+    PlayerPosition pb = b.estimate();
+    ASSERT_TRUE(pa.valid);
+    EXPECT_NEAR(pa.x, -29.4f, 0.7f);
+    EXPECT_NEAR(pa.y, 10.0f, 0.7f);
+    EXPECT_FLOAT_EQ(pa.x, pb.x);
+    EXPECT_FLOAT_EQ(pa.y, pb.y);
+}
+
+// =============================================================================
+// Tests de fast_math
+// =============================================================================
+
+#include "fast_math.h"
+
+TEST(FastMathTest, PolyAtan2WithinErrorBound) {
+    float max_error = 0;
+    for (int i = 0; i < 3600; ++i) {
+        float a = (i - 1800) * 0.1f * fast_math::DEG_TO_RAD;
+        for (float r : {0.01f, 1.0f, 100.0f}) {
+            float y = r * sinf(a);
+            float x = r * cosf(a);
+            max_error = std::max(max_error, fabsf(fast_math::poly_atan2(y, x) - atan2f(y, x)));
+        }
+    }
+    EXPECT_LT(max_error, 1e-5f);
+    EXPECT_FLOAT_EQ(fast_math::poly_atan2(0, 0), 0.0f);
+}
+
+TEST(FastMathTest, PolySincosWithinErrorBound) {
+    float max_error = 0;
+    for (int i = -3600; i <= 3600; ++i) {
+        float a = i * 0.1f * fast_math::DEG_TO_RAD;
+        float s, c;
+        fast_math::poly_sincos(a, s, c);
+        max_error = std::max(max_error, fabsf(s - sinf(a)));
+        max_error = std::max(max_error, fabsf(c - cosf(a)));
+    }
+    EXPECT_LT(max_error, 1e-6f);
+}
+
+TEST(FastMathTest, NormalizeAngleIsHalfOpen) {
+    EXPECT_FLOAT_EQ(fast_math::normalize_angle(0.0f), 0.0f);
+    EXPECT_FLOAT_EQ(fast_math::normalize_angle(179.5f), 179.5f);
+    EXPECT_FLOAT_EQ(fast_math::normalize_angle(180.0f), -180.0f);
+    EXPECT_FLOAT_EQ(fast_math::normalize_angle(-180.0f), -180.0f);
+    EXPECT_FLOAT_EQ(fast_math::normalize_angle(359.0f), -1.0f);
+    EXPECT_FLOAT_EQ(fast_math::normalize_angle(-190.0f), 170.0f);
+    EXPECT_FLOAT_EQ(fast_math::normalize_angle(720.5f), 0.5f);
+    
+    // Cerca de ±180 el redondeo no puede sacar el resultado del rango
+    const float boundary[] = {179.99f, -180.01f, 539.99f, 179.99999f, -180.00001f, -540.0f};
+    for (float angle : boundary) {
+        float result = fast_math::normalize_angle(angle);
+        EXPECT_GE(result, -180.0f) << angle;
+        EXPECT_LT(result, 180.0f) << angle;
+    }
+    EXPECT_NEAR(fast_math::normalize_angle(179.99f), 179.99f, 1e-3f);
+    EXPECT_NEAR(fast_math::normalize_angle(-180.01f), 179.99f, 1e-3f);
+    EXPECT_NEAR(fast_math::normalize_angle(539.99f), 179.99f, 1e-3f);
+}
+
+// =============================================================================
+// Tests de la variante en punto fijo (Q16.16)
+// =============================================================================
+
+#include "fixed_point.h"
+
+namespace {
+
+BasicFlagInfo<Fixed16> to_fixed(const FlagInfo& f) {
+    return BasicFlagInfo<Fixed16>(f.id, f.distance, f.angle);
+}
+
+} // namespace
+
+TEST(FixedPointTest, ArithmeticRoundsAndSaturates) {
+    EXPECT_EQ(Fixed16(1.5f).raw(), 3 * Fixed16::ONE / 2);
+    EXPECT_FLOAT_EQ((Fixed16(2.5f) * Fixed16(-4)).to_float(), -10.0f);
+    EXPECT_FLOAT_EQ((Fixed16(7) / Fixed16(2)).to_float(), 3.5f);
+    EXPECT_EQ((Fixed16(30000) + Fixed16(30000)).raw(), Fixed16::RAW_MAX);
+    EXPECT_EQ((Fixed16(200) * Fixed16(-200)).raw(), Fixed16::RAW_MIN);
+    EXPECT_EQ((Fixed16(1) / Fixed16()).raw(), Fixed16::RAW_MAX);
+    EXPECT_TRUE(Fixed16(0.7f) < Fixed16(1));
+}
+
+TEST(FixedPointTest, SqrtAndCordicMatchFloat) {
+    for (float v : {0.0001f, 0.25f, 2.0f, 100.0f, 12100.0f, 32000.0f}) {
+        float exact = sqrtf(Fixed16(v).to_float());  // Raíz de la entrada ya cuantizada
+        EXPECT_NEAR(scalar::sqrt(Fixed16(v)).to_float(), exact, 1e-4f * exact + 2e-5f) << v;
+    }
+    for (int deg = -180; deg < 180; deg += 7) {
+        Fixed16 s, c;
+        scalar::sincos_deg(Fixed16(deg), s, c);
+        float rad = deg * fast_math::DEG_TO_RAD;
+        EXPECT_NEAR(s.to_float(), sinf(rad), 1e-4f) << deg;
+        EXPECT_NEAR(c.to_float(), cosf(rad), 1e-4f) << deg;
+        
+        float x = 40.0f * cosf(rad), y = 40.0f * sinf(rad);
+        float angle = scalar::atan2_deg(Fixed16(y), Fixed16(x)).to_float();
+        EXPECT_NEAR(scalar::normalize_angle(angle - deg), 0.0f, 0.01f) << deg;
+    }
+    EXPECT_FLOAT_EQ(scalar::normalize_angle(Fixed16(540)).to_float(), -180.0f);
+}
+
+TEST(FixedPointTest, LocalizationMatchesFloatBuild) {
+    const float poses[][3] = {{-20, 10, 45}, {30, -25, -120}, {0.5f, 30, 179}};
+    for (const auto& p : poses) {
+        FlagInfo flags[4];
+        uint8_t n = observe_center_flags(flags, p[0], p[1], p[2]);
+        BasicFlagInfo<Fixed16> fixed_flags[4];
+        for (uint8_t i = 0; i < n; ++i) fixed_flags[i] = to_fixed(flags[i]);
+        
+        PositionFix ref = Localization::estimate_fix(flags, n);
+        BasicPositionFix<Fixed16> fix = BasicLocalization<Fixed16>::estimate_fix(fixed_flags, n);
+        
+        ASSERT_TRUE(fix.position.valid);
+        EXPECT_NEAR(fix.position.x.to_float(), ref.position.x, 0.01f);
+        EXPECT_NEAR(fix.position.y.to_float(), ref.position.y, 0.01f);
+        EXPECT_NEAR(Localization::normalize_angle(fix.position.heading.to_float() - ref.position.heading), 0.0f, 0.05f);
+    }
+}
+
+TEST(FixedPointTest, GameLogicDecidesLikeFloatBuild) {
+    const float balls[][2] = {{20, 15}, {4, -30}, {0.5f, 5}, {2, 90}};
+    for (PlayerRole role : {PlayerRole::STRIKER, PlayerRole::DEFENDER, PlayerRole::STRIKER_GK_SIM}) {
+        for (const auto& b : balls) {
+            GameLogic ref;
+            BasicGameLogic<Fixed16> logic;
+            SensorData sensors;
+            BasicSensorData<Fixed16> fixed_sensors;
+            sensors.status = fixed_sensors.status = GameStatus::PLAYING;
+            sensors.role = fixed_sensors.role = role;
+            sensors.ball = ObjectInfo(b[0], b[1]);
+            fixed_sensors.ball = BasicObjectInfo<Fixed16>(b[0], b[1]);
+            
+            Action expected = ref.decide_action(sensors);
+            BasicAction<Fixed16> action = logic.decide_action(fixed_sensors);
+            
+            EXPECT_EQ(action.type, expected.type);
+            EXPECT_FLOAT_EQ(action.params[0].to_float(), expected.params[0]);
+            EXPECT_FLOAT_EQ(action.params[1].to_float(), expected.params[1]);
+        }
+    }
+}
+
+// =============================================================================
+// Tests de BatchLocalization (SoA + SIMD)
+// =============================================================================
+
+#include "batch_localization.h"
+#include <random>
+
+TEST(BatchLocalizationTest, MatchesScalarPathWithinTolerance) {
+    constexpr uint16_t AGENTS = 37;  // No múltiplo del ancho SIMD
+    BatchLocalization<AGENTS> batch;
+    FlagInfo flags[AGENTS][SensorData::MAX_FLAGS];
+    uint8_t counts[AGENTS];
+    
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> ux(-50.0f, 50.0f), uy(-32.0f, 32.0f), uh(-180.0f, 180.0f);
+    std::uniform_real_distribution<float> noise(-0.3f, 0.3f);
+    for (uint16_t a = 0; a < AGENTS; ++a) {
+        float x = ux(rng), y = uy(rng), h = uh(rng);
+        counts[a] = static_cast<uint8_t>(a % (SensorData::MAX_FLAGS + 1));
+        for (uint8_t k = 0; k < counts[a]; ++k) {
+            FlagId id = static_cast<FlagId>((a * 7 + k * 5) % FieldFlags::COUNT);
+            flags[a][k] = observe(id, x, y, h, noise(rng));
+        }
+        batch.set_agent(a, flags[a], counts[a]);
+    }
+    
+    PlayerPosition poses[AGENTS];
+    batch.estimate(poses, AGENTS);
+    
+    for (uint16_t a = 0; a < AGENTS; ++a) {
+        PlayerPosition ref = Localization::estimate_position(flags[a], counts[a]);
+        ASSERT_EQ(poses[a].valid, ref.valid) << "agent " << a;
+        if (!ref.valid) continue;
+        EXPECT_NEAR(poses[a].x, ref.x, BatchLocalization<AGENTS>::POSITION_TOLERANCE) << "agent " << a;
+        EXPECT_NEAR(poses[a].y, ref.y, BatchLocalization<AGENTS>::POSITION_TOLERANCE) << "agent " << a;
+        EXPECT_NEAR(Localization::normalize_angle(poses[a].heading - ref.heading), 0.0f,
+                    BatchLocalization<AGENTS>::HEADING_TOLERANCE) << "agent " << a;
+    }
+    // Los agentes con exactamente 2 banderas pasan por la ruta escalar
+    EXPECT_GE(batch.fallback_count(), 3);
+}
+
+TEST(BatchLocalizationTest, ReloadingAnAgentClearsPreviousFlags) {
+    BatchLocalization<4> batch;
+    FlagInfo flags[4];
+    uint8_t n = observe_center_flags(flags, 10.0f, 5.0f, 20.0f);
+    batch.set_agent(1, flags, n);
+    batch.set_agent(1, flags, 1);
+    
+    PlayerPosition poses[4];
+    batch.estimate(poses);
+    EXPECT_FALSE(poses[0].valid);
+    EXPECT_FALSE(poses[1].valid);
+}
+
+// =============================================================================
+// Tests de BallTracker
+// =============================================================================
+
+#include "ball_tracker.h"
+
+namespace {
+
+// Observación relativa exacta del balón desde una pose
+ObjectInfo observe_ball(float bx, float by, const PlayerPosition& pose) {
+    float dx = bx - pose.x;
+    float dy = by - pose.y;
+    return ObjectInfo(std::sqrt(dx * dx + dy * dy),
+                      Localization::normalize_angle(std::atan2(dy, dx) * 180.0f / 3.14159265f - pose.heading));
+}
+
+} // namespace
+
+TEST(BallTrackerTest, ConvertsObservationToFieldCoordinates) {
+    BallTracker tracker;
+    EXPECT_FALSE(tracker.state().valid);
+    
+    PlayerPosition pose(10.0f, 5.0f, 90.0f);
+    tracker.update(ObjectInfo(5.0f, 0.0f), pose, 1);
+    
+    BallState s = tracker.state();
+    ASSERT_TRUE(s.valid);
+    EXPECT_NEAR(s.x, 10.0f, 0.01f);
+    EXPECT_NEAR(s.y, 10.0f, 0.01f);
+    
+    // Sin pose válida la observación no se puede usar
+    BallTracker blind;
+    blind.update(ObjectInfo(5.0f, 0.0f), PlayerPosition(), 1);
+    EXPECT_FALSE(blind.initialized());
+}
+
+TEST(BallTrackerTest, PredictsRollingBallWithDecay) {
+    BallTracker tracker;
+    PlayerPosition pose(0.0f, -10.0f, 90.0f);
+    float bx = 0, vx = 1.5f;
+    for (int i = 0; i < 10; ++i) {
+        tracker.update(observe_ball(bx, 0.0f, pose), pose, 1);
+        bx += vx;
+        vx *= BallTrackerConfig::BALL_DECAY;
+    }
+    
+    // Sale del cono de visión: cinco ciclos sólo con predicción
+    for (int i = 0; i < 5; ++i) {
+        tracker.update(ObjectInfo(), pose, 1);
+        if (i < 4) {
+            bx += vx;
+            vx *= BallTrackerConfig::BALL_DECAY;
+        }
+    }
+    
+    BallState s = tracker.state();
+    ASSERT_TRUE(s.valid);
+    EXPECT_EQ(tracker.unseen_cycles(), 5);
+    EXPECT_NEAR(s.x, bx, 0.5f);
+    EXPECT_NEAR(s.y, 0.0f, 0.2f);
+    EXPECT_NEAR(s.vx, vx, 0.15f);
+    
+    ObjectInfo relative = tracker.relative_to(pose);
+    EXPECT_TRUE(relative.visible);
+    EXPECT_NEAR(relative.angle, observe_ball(bx, 0.0f, pose).angle, 3.0f);
+}
+
+TEST(BallTrackerTest, ReseedsAfterKickAndExpiresWhenUnseen) {
+    BallTracker tracker;
+    PlayerPosition pose(0.0f, 0.0f, 0.0f);
+    for (int i = 0; i < 5; ++i) {
+        tracker.update(observe_ball(3.0f, 0.0f, pose), pose, 1);
+    }
+    
+    // Patada: el balón aparece lejos de la predicción
+    tracker.predict();
+    EXPECT_FALSE(tracker.correct(observe_ball(15.0f, 4.0f, pose), pose));
+    EXPECT_NEAR(tracker.state().x, 15.0f, 0.01f);
+    EXPECT_NEAR(tracker.state().vx, 0.0f, 1e-6f);
+    
+    for (int i = 0; i <= BallTrackerConfig::MAX_UNSEEN_CYCLES; ++i) {
+        tracker.update(ObjectInfo(), pose, 1);
+    }
+    EXPECT_FALSE(tracker.state().valid);
+    EXPECT_FALSE(tracker.relative_to(pose).visible);
+}
+
+TEST(BallTrackerTest, AdvancesByElapsedServerCycles) {
+    EXPECT_EQ(BallTracker::elapsed_cycles(0), 1);
+    EXPECT_EQ(BallTracker::elapsed_cycles(290000), 3);
+    EXPECT_EQ(BallTracker::elapsed_cycles(460000), 5);
+    EXPECT_EQ(BallTracker::elapsed_cycles(60000000), BallTrackerConfig::MAX_UNSEEN_CYCLES + 1);
+    
+    // El backend publica cada 3 ciclos: un update de 3 equivale a tres de 1
+    PlayerPosition pose(0.0f, -10.0f, 90.0f);
+    BallTracker sparse;
+    BallTracker dense;
+    float bx = 0, vx = 1.5f;
+    for (int i = 0; i < 4; ++i) {
+        sparse.update(observe_ball(bx, 0.0f, pose), pose, 3);
+        for (int k = 0; k < 3; ++k) {
+            dense.update(k == 2 ? observe_ball(bx, 0.0f, pose) : ObjectInfo(), pose, 1);
+        }
+        for (int k = 0; k < 3; ++k) {
+            bx += vx;
+            vx *= BallTrackerConfig::BALL_DECAY;
+        }
+    }
+    EXPECT_NEAR(sparse.state().x, dense.state().x, 1e-3f);
+    EXPECT_NEAR(sparse.state().vx, dense.state().vx, 1e-3f);
+    EXPECT_NEAR(sparse.state().vx, vx, 0.3f);
+    
+    // Los ciclos sin verlo se cuentan en ciclos del servidor, no en mensajes
+    sparse.update(ObjectInfo(), pose, 5);
+    EXPECT_EQ(sparse.unseen_cycles(), 5);
+    sparse.update(ObjectInfo(), pose, BallTrackerConfig::MAX_UNSEEN_CYCLES);
+    EXPECT_FALSE(sparse.state().valid);
+}
+
+TEST_F(GameLogicTest, StrikerTurnsTowardPredictedBallOutOfView) {
+    sensors.status = GameStatus::PLAYING;
+    sensors.role = PlayerRole::STRIKER;
+    sensors.ball_estimate = ObjectInfo(8.0f, 120.0f);
+    
+    Action action = logic.decide_action(sensors);
+    EXPECT_EQ(action.type, ActionType::TURN);
+    EXPECT_FLOAT_EQ(action.params[0], 120.0f);
+    
+    // Predicción dentro del cono pero sin verlo: la predicción no sirve
+    sensors.ball_estimate = ObjectInfo(8.0f, 10.0f);
+    action = logic.decide_action(sensors);
+    EXPECT_EQ(action.type, ActionType::TURN);
+    EXPECT_FLOAT_EQ(action.params[0], 30.0f);
+}
+
+// =============================================================================
+// Tests de SensorJson
+// =============================================================================
+
+#include "sensor_json.h"
+
+TEST(SensorJsonTest, DecodesBackendPayload) {
+    const char* json =
+        "{\"status\": \"PLAYING\", \"role\": \"STRIKER_GK_SIM\", \"time\": 120, "
+        "\"sensors\": {\"ball\": {\"dist\": 10.5, \"angle\": -15.0}, "
+        "\"extra\": {\"nested\": [1, [2, 3], {\"a\": null}], \"ok\": true}, "
+        "\"teammates\": [{\"id\": 2, \"dist\": 5.0, \"angle\": 20.0}], "
+        "\"flags\": [{\"name\": \"f c\", \"dist\": 15.2, \"angle\": 30}, "
+        "{\"name\": \"f x y\", \"dist\": 1.0, \"angle\": 0}, "
+        "{\"angle\": -45, \"name\": \"g r\", \"dist\": 40.5}], "
+        "\"lines\": [{\"name\": \"l r\", \"dist\": 20.5, \"angle\": -60}]}}";
+    
+    SensorData sensors;
+    ASSERT_TRUE(SensorJson::decode(json, sensors));
+    EXPECT_EQ(sensors.status, GameStatus::PLAYING);
+    EXPECT_EQ(sensors.role, PlayerRole::STRIKER_GK_SIM);
+    EXPECT_TRUE(sensors.ball.visible);
+    EXPECT_FLOAT_EQ(sensors.ball.distance, 10.5f);
+    EXPECT_FLOAT_EQ(sensors.ball.angle, -15.0f);
+    EXPECT_FALSE(sensors.goal.visible);
+    
+    ASSERT_EQ(sensors.teammate_count, 1);
+    EXPECT_EQ(sensors.teammates[0].player_id, 2);
+    
+    // La bandera desconocida se descarta; el orden de las claves no importa
+    ASSERT_EQ(sensors.flag_count, 2);
+    EXPECT_EQ(sensors.flags[0].id, FlagId::F_C);
+    EXPECT_FLOAT_EQ(sensors.flags[0].distance, 15.2f);
+    EXPECT_EQ(sensors.flags[1].id, FlagId::G_R);
+    EXPECT_FLOAT_EQ(sensors.flags[1].angle, -45.0f);
+    
+    ASSERT_EQ(sensors.line_count, 1);
+    EXPECT_EQ(sensors.lines[0].id, LineId::L_R);
+}
+
+TEST(SensorJsonTest, MapsStatusNamesAndMissingObjects) {
+    SensorData sensors;
+    ASSERT_TRUE(SensorJson::decode("{\"status\":\"kick_off_l\",\"role\":\"GOALKEEPER\","
+                                   "\"sensors\":{\"ball\":null,\"flags\":[]}}", sensors));
+    EXPECT_EQ(sensors.status, GameStatus::BEFORE_KICK_OFF);
+    EXPECT_EQ(sensors.role, PlayerRole::GOALKEEPER);
+    EXPECT_FALSE(sensors.ball.visible);
+    EXPECT_EQ(sensors.flag_count, 0);
+    
+    // Un balón sin ángulo no se considera visible
+    ASSERT_TRUE(SensorJson::decode("{\"sensors\": {\"ball\": {\"dist\": 3.0}}}", sensors));
+    EXPECT_EQ(sensors.status, GameStatus::IDLE);
+    EXPECT_FALSE(sensors.ball.visible);
+}
+
+TEST(SensorJsonTest, KeepsAtMostMaxFlags) {
+    std::string json = "{\"sensors\": {\"flags\": [";
+    for (int i = 0; i < SensorData::MAX_FLAGS + 5; ++i) {
+        json += i ? ", " : "";
+        json += "{\"name\": \"f c\", \"dist\": 1.0, \"angle\": 0}";
+    }
+    json += "]}}";
+    
+    SensorData sensors;
+    ASSERT_TRUE(SensorJson::decode(json, sensors));
+    EXPECT_EQ(sensors.flag_count, SensorData::MAX_FLAGS);
+}
+
+TEST(SensorJsonTest, RejectsMalformedPayloads) {
+    const char* bad[] = {
+        "",
+        "{\"status\": \"PLAYING\"",
+        "{\"status\": \"PLAYING\"} trailing",
+        "{\"sensors\": {\"ball\": {\"dist\": abc, \"angle\": 0}}}",
+        "{\"sensors\": {\"ball\": {\"dist\": NaN, \"angle\": 0}}}",
+        "{\"sensors\": {\"ball\": {\"dist\": 1.0, \"angle\": -Infinity}}}",
+        "{\"sensors\": {\"flags\": [{\"name\": \"f c\", \"dist\": 1.0,]}}",
+        "{\"status: \"PLAYING\"}",
+    };
+    for (const char* json : bad) {
+        SensorData sensors;
+        EXPECT_FALSE(SensorJson::decode(json, sensors)) << json;
+    }
+}
+
+// =============================================================================
+// Tests de WireFormat
+// =============================================================================
+
+#include "wire_format.h"
+#include <cstring>
+
+namespace {
+
+SensorData wire_sample() {
+    SensorData s;
+    s.status = GameStatus::PLAYING;
+    s.role = PlayerRole::GOALKEEPER;
+    s.ball = ObjectInfo(10.5f, -15.0f);
+    s.teammates[s.teammate_count++] = TeammateInfo(7, 5.2f, 20.0f);
+    s.flags[s.flag_count++] = FlagInfo(FlagId::F_C, 15.2f, 30.0f);
+    s.flags[s.flag_count++] = FlagInfo("f r b 30", 40.4f, -12.0f);
+    s.lines[s.line_count++] = LineInfo(LineId::L_R, 20.5f, -60.0f);
+    s.stamina = 7421;
+    s.speed = 0.83f;
+    return s;
+}
+
+} // namespace
+
+TEST(WireFormatTest, EncodesFixedLittleEndianLayout) {
+    uint8_t buffer[WireFormat::MAX_SENSOR_SIZE];
+    size_t size = WireFormat::encode(wire_sample(), buffer, sizeof(buffer));
+    
+    // Mismos bytes que backend-python/tests/test_wire_format.py
+    ASSERT_EQ(size, 22u + 5u * 4u);
+    EXPECT_EQ(buffer[0], 0x52);
+    EXPECT_EQ(buffer[1], WireFormat::VERSION);
+    EXPECT_EQ(buffer[2], static_cast<uint8_t>(WireKind::SENSOR_DATA));
+    EXPECT_EQ(buffer[4], 2);   // PLAYING
+    EXPECT_EQ(buffer[5], 4);   // GOALKEEPER
+    EXPECT_EQ(buffer[6], 1);   // Sólo balón
+    EXPECT_EQ(buffer[10], 1050 & 0xFF);
+    EXPECT_EQ(buffer[11], 1050 >> 8);
+    EXPECT_EQ(buffer[12], static_cast<uint8_t>(-1500 & 0xFF));
+    EXPECT_EQ(buffer[32], 54);  // f r b 30
+}
+
+TEST(WireFormatTest, SensorRoundTripKeepsCentiUnits) {
+    SensorData in = wire_sample();
+    uint8_t buffer[WireFormat::MAX_SENSOR_SIZE];
+    size_t size = WireFormat::encode(in, buffer, sizeof(buffer));
+    
+    SensorData out;
+    ASSERT_TRUE(WireFormat::decode(buffer, size, out));
+    EXPECT_EQ(out.status, in.status);
+    EXPECT_EQ(out.role, in.role);
+    EXPECT_TRUE(out.ball.visible);
+    EXPECT_NEAR(out.ball.distance, 10.5f, 0.005f);
+    EXPECT_FALSE(out.goal.visible);
+    EXPECT_FLOAT_EQ(out.stamina, 7421.0f);
+    EXPECT_NEAR(out.speed, 0.83f, 0.005f);
+    
+    ASSERT_EQ(out.teammate_count, 1);
+    EXPECT_EQ(out.teammates[0].player_id, 7);
+    ASSERT_EQ(out.flag_count, 2);
+    EXPECT_EQ(out.flags[1].id, FlagId::F_R_B_30);
+    EXPECT_NEAR(out.flags[1].distance, 40.4f, 0.005f);
+    EXPECT_NEAR(out.flags[1].angle, -12.0f, 0.005f);
+    ASSERT_EQ(out.line_count, 1);
+    EXPECT_EQ(out.lines[0].id, LineId::L_R);
+    EXPECT_NEAR(out.lines[0].angle, -60.0f, 0.005f);
+}
+
+TEST(WireFormatTest, QuantizationRoundsAndSaturates) {
+    SensorData in;
+    in.ball = ObjectInfo(0.126f, -0.126f);
+    in.goal = ObjectInfo(500.0f, -400.0f);
+    uint8_t buffer[WireFormat::MAX_SENSOR_SIZE];
+    size_t size = WireFormat::encode(in, buffer, sizeof(buffer));
+    
+    SensorData out;
+    ASSERT_TRUE(WireFormat::decode(buffer, size, out));
+    EXPECT_FLOAT_EQ(out.ball.distance, 0.13f);
+    EXPECT_FLOAT_EQ(out.ball.angle, -0.13f);
+    EXPECT_FLOAT_EQ(out.goal.distance, 327.67f);
+    EXPECT_FLOAT_EQ(out.goal.angle, -327.68f);
+}
+
+TEST(WireFormatTest, RejectsForeignOrInconsistentPayloads) {
+    uint8_t buffer[WireFormat::MAX_SENSOR_SIZE];
+    size_t size = WireFormat::encode(wire_sample(), buffer, sizeof(buffer));
+    SensorData out;
+    
+    EXPECT_FALSE(WireFormat::decode(buffer, size - 1, out));
+    EXPECT_EQ(WireFormat::encode(wire_sample(), buffer, size - 1), 0u);
+    
+    const char* json = "{\"status\": \"PLAYING\"}";
+    EXPECT_FALSE(WireFormat::is_wire(reinterpret_cast<const uint8_t*>(json), std::strlen(json)));
+    
+    WireFormat::encode(wire_sample(), buffer, sizeof(buffer));
+    buffer[1] = WireFormat::VERSION + 1;
+    EXPECT_FALSE(WireFormat::decode(buffer, size, out));
+    
+    WireFormat::encode(wire_sample(), buffer, sizeof(buffer));
+    buffer[5] = 200;  // Rol inexistente
+    EXPECT_FALSE(WireFormat::decode(buffer, size, out));
+    
+    // Un id de bandera desconocido se descarta sin invalidar el resto
+    WireFormat::encode(wire_sample(), buffer, sizeof(buffer));
+    buffer[27] = 0xEE;
+    ASSERT_TRUE(WireFormat::decode(buffer, size, out));
+    EXPECT_EQ(out.flag_count, 1);
+    EXPECT_EQ(out.flags[0].id, FlagId::F_R_B_30);
+}
+
+TEST(WireFormatTest, ActionRoundTrip) {
+    uint8_t buffer[WireFormat::ACTION_SIZE];
+    ASSERT_EQ(WireFormat::encode(Action::kick(100.0f, -45.5f), buffer, sizeof(buffer)), 9u);
+    EXPECT_EQ(buffer[2], static_cast<uint8_t>(WireKind::ACTION));
+    
+    Action out;
+    ASSERT_TRUE(WireFormat::decode(buffer, sizeof(buffer), out));
+    EXPECT_EQ(out.type, ActionType::KICK);
+    EXPECT_FLOAT_EQ(out.params[0], 100.0f);
+    EXPECT_FLOAT_EQ(out.params[1], -45.5f);
+    
+    // Un estado no se acepta como acción
+    SensorData sensors;
+    EXPECT_FALSE(WireFormat::decode(buffer, sizeof(buffer), sensors));
+}
+
+// =============================================================================
+// Tests de SensorDataView
+// =============================================================================
+
+#include "sensor_view.h"
+
+TEST(SensorDataViewTest, ReadsFieldsStraightFromPayload) {
+    SensorData in = wire_sample();
+    uint8_t buffer[WireFormat::MAX_SENSOR_SIZE];
+    size_t size = WireFormat::encode(in, buffer, sizeof(buffer));
+    SensorData decoded;
+    ASSERT_TRUE(WireFormat::decode(buffer, size, decoded));
+    
+    SensorDataView view;
+    ASSERT_TRUE(view.bind(buffer, size));
+    EXPECT_EQ(view.status(), decoded.status);
+    EXPECT_EQ(view.role(), decoded.role);
+    EXPECT_TRUE(view.ball().visible);
+    EXPECT_FLOAT_EQ(view.ball().distance, decoded.ball.distance);
+    EXPECT_FALSE(view.goal().visible);
+    EXPECT_FLOAT_EQ(view.stamina(), decoded.stamina);
+    EXPECT_FLOAT_EQ(view.speed(), decoded.speed);
+    
+    ASSERT_EQ(view.teammate_count(), 1);
+    EXPECT_EQ(view.teammate(0).player_id, 7);
+    ASSERT_EQ(view.flag_count(), 2);
+    EXPECT_EQ(view.flag(1).id, FlagId::F_R_B_30);
+    EXPECT_FLOAT_EQ(view.flag(1).angle, decoded.flags[1].angle);
+    ASSERT_EQ(view.line_count(), 1);
+    EXPECT_EQ(view.line(0).id, LineId::L_R);
+    
+    // Las banderas desconocidas no llegan a la localización
+    buffer[27] = 0xEE;
+    ASSERT_TRUE(view.bind(buffer, size));
+    EXPECT_EQ(view.flag(0).id, FlagId::UNKNOWN);
+    FlagInfo flags[SensorData::MAX_FLAGS];
+    ASSERT_EQ(view.copy_flags(flags), 1);
+    EXPECT_EQ(flags[0].id, FlagId::F_R_B_30);
+}
+
+TEST(SensorDataViewTest, RejectsInvalidPayload) {
+    uint8_t buffer[WireFormat::MAX_SENSOR_SIZE];
+    size_t size = WireFormat::encode(wire_sample(), buffer, sizeof(buffer));
+    
+    SensorDataView view;
+    EXPECT_FALSE(view.bind(buffer, size - 1));
+    EXPECT_FALSE(view.valid());
+    EXPECT_EQ(view.status(), GameStatus::IDLE);
+    EXPECT_FALSE(view.ball().visible);
+    EXPECT_EQ(view.flag_count(), 0);
+}
+
+TEST(SensorDataViewTest, DecideActionMatchesSensorData) {
+    SensorData in;
+    in.status = GameStatus::PLAYING;
+    in.role = PlayerRole::STRIKER;
+    in.ball = ObjectInfo(8.0f, 20.0f);
+    uint8_t buffer[WireFormat::MAX_SENSOR_SIZE];
+    size_t size = WireFormat::encode(in, buffer, sizeof(buffer));
+    
+    SensorDataView view;
+    ASSERT_TRUE(view.bind(buffer, size));
+    GameLogic from_struct;
+    GameLogic from_view;
+    Action expected = from_struct.decide_action(in);
+    Action actual = from_view.decide_action(view);
+    EXPECT_EQ(actual.type, expected.type);
+    EXPECT_FLOAT_EQ(actual.params[0], expected.params[0]);
+    EXPECT_FLOAT_EQ(actual.params[1], expected.params[1]);
+    
+    // La predicción del balón la fija el agente sobre la vista
+    in.ball = ObjectInfo();
+    in.ball_estimate = ObjectInfo(6.0f, 120.0f);
+    SensorDataView over_struct;
+    over_struct.bind(in);
+    Action turn = from_view.decide_action(over_struct);
+    EXPECT_EQ(turn.type, ActionType::TURN);
+    EXPECT_FLOAT_EQ(turn.params[0], 120.0f);
+}
+
+// =============================================================================
+// Tests de deltas del WireFormat
+// =============================================================================
+
+namespace {
+
+size_t encode_wire(const SensorData& s, uint8_t* out, uint8_t sequence) {
+    return WireFormat::encode(s, out, WireFormat::MAX_SENSOR_SIZE, sequence);
+}
+
+} // namespace
+
+TEST(WireDeltaTest, StaticSceneIsHeaderOnly) {
+    uint8_t keyframe[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t current[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t delta[WireFormat::MAX_DELTA_SIZE];
+    size_t kf_size = encode_wire(wire_sample(), keyframe, 7);
+    size_t cur_size = encode_wire(wire_sample(), current, 8);
+    
+    size_t delta_size = WireFormat::encode_delta(keyframe, kf_size, current, cur_size, 8, delta, sizeof(delta));
+    ASSERT_EQ(delta_size, WireFormat::DELTA_FIXED_SIZE);
+    EXPECT_EQ(delta[2], static_cast<uint8_t>(WireKind::SENSOR_DELTA));
+    EXPECT_EQ(delta[3], 8);
+    EXPECT_EQ(delta[4], 7);
+    EXPECT_EQ(delta[5], 0);
+    
+    uint8_t rebuilt[WireFormat::MAX_SENSOR_SIZE];
+    ASSERT_EQ(WireFormat::apply_delta(keyframe, kf_size, delta, delta_size, rebuilt, sizeof(rebuilt)), cur_size);
+    EXPECT_EQ(std::memcmp(rebuilt, current, cur_size), 0);
+}
+
+TEST(WireDeltaTest, SendsOnlyChangedFieldsAndRecords) {
+    SensorData before = wire_sample();
+    SensorData after = wire_sample();
+    after.ball = ObjectInfo(9.8f, -14.0f);
+    after.flags[1].distance = 39.9f;                                   // Cambia un registro
+    after.flags[after.flag_count++] = FlagInfo(FlagId::G_R, 30.0f, 5.0f);  // Aparece otro
+    after.line_count = 0;                                              // Desaparece la línea
+    
+    uint8_t keyframe[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t current[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t delta[WireFormat::MAX_DELTA_SIZE];
+    size_t kf_size = encode_wire(before, keyframe, 1);
+    size_t cur_size = encode_wire(after, current, 2);
+    size_t delta_size = WireFormat::encode_delta(keyframe, kf_size, current, cur_size, 2, delta, sizeof(delta));
+    
+    // ball (4) + flags {3 + id + 2 registros} + lines {3}
+    EXPECT_EQ(delta[5], 0x04 | 0x40 | 0x80);
+    EXPECT_EQ(delta_size, WireFormat::DELTA_FIXED_SIZE + 4 + (3 + 1 + 2 * 5) + 3);
+    EXPECT_LT(delta_size, cur_size);
+    
+    uint8_t rebuilt[WireFormat::MAX_SENSOR_SIZE];
+    size_t size = WireFormat::apply_delta(keyframe, kf_size, delta, delta_size, rebuilt, sizeof(rebuilt));
+    ASSERT_EQ(size, cur_size);
+    EXPECT_EQ(std::memcmp(rebuilt, current, cur_size), 0);
+    
+    SensorData out;
+    ASSERT_TRUE(WireFormat::decode(rebuilt, size, out));
+    EXPECT_NEAR(out.ball.distance, 9.8f, 0.005f);
+    ASSERT_EQ(out.flag_count, 3);
+    EXPECT_EQ(out.flags[2].id, FlagId::G_R);
+    EXPECT_EQ(out.line_count, 0);
+}
+
+TEST(WireDeltaTest, RejectsDeltaForAnotherKeyframe) {
+    uint8_t keyframe[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t other[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t delta[WireFormat::MAX_DELTA_SIZE];
+    uint8_t rebuilt[WireFormat::MAX_SENSOR_SIZE];
+    size_t kf_size = encode_wire(wire_sample(), keyframe, 10);
+    size_t other_size = encode_wire(wire_sample(), other, 11);
+    size_t delta_size = WireFormat::encode_delta(keyframe, kf_size, keyframe, kf_size, 12, delta, sizeof(delta));
+    
+    EXPECT_EQ(WireFormat::apply_delta(other, other_size, delta, delta_size, rebuilt, sizeof(rebuilt)), 0u);
+    EXPECT_EQ(WireFormat::apply_delta(keyframe, kf_size, delta, delta_size - 1, rebuilt, sizeof(rebuilt)), 0u);
+}
+
+TEST(WireDeltaTest, StreamDropsDeltasUntilKeyframe) {
+    SensorData moved = wire_sample();
+    moved.ball = ObjectInfo(2.0f, 0.0f);
+    uint8_t keyframe[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t current[WireFormat::MAX_SENSOR_SIZE];
+    uint8_t delta[WireFormat::MAX_DELTA_SIZE];
+    size_t kf_size = encode_wire(wire_sample(), keyframe, 3);
+    size_t cur_size = encode_wire(moved, current, 4);
+    size_t delta_size = WireFormat::encode_delta(keyframe, kf_size, current, cur_size, 4, delta, sizeof(delta));
+    
+    SensorStream stream;
+    size_t size = 0;
+    EXPECT_EQ(stream.receive(delta, delta_size, size), nullptr);
+    EXPECT_EQ(stream.dropped(), 1u);
+    
+    ASSERT_NE(stream.receive(keyframe, kf_size, size), nullptr);
+    EXPECT_EQ(size, kf_size);
+    const uint8_t* state = stream.receive(delta, delta_size, size);
+    ASSERT_NE(state, nullptr);
+    
+    SensorDataView view;
+    ASSERT_TRUE(view.bind(state, size));
+    EXPECT_NEAR(view.ball().distance, 2.0f, 0.005f);
+    EXPECT_EQ(stream.keyframes(), 1u);
+    EXPECT_EQ(stream.deltas(), 1u);
+}
+
+// =============================================================================
+// Tests de ActionJson
+// =============================================================================
+
+#include "action_json.h"
+#include <cstdio>
+
+TEST(ActionJsonTest, WritesBackendFormat) {
+    char buffer[ActionJson::MAX_SIZE];
+    size_t size = ActionJson::encode(Action::dash(80.0f, -30.5f), buffer, sizeof(buffer));
+    EXPECT_EQ(std::string(buffer, size), "{\"action\":\"dash\",\"params\":[80.0,-30.5]}");
+    EXPECT_EQ(buffer[size], '\0');
+    
+    size = ActionJson::encode(Action::turn(-0.96f), buffer, sizeof(buffer));
+    EXPECT_EQ(std::string(buffer, size), "{\"action\":\"turn\",\"params\":[-1.0,0.0]}");
+    
+    size = ActionJson::encode(Action::catch_ball(180.0f), buffer, sizeof(buffer));
+    EXPECT_EQ(std::string(buffer, size), "{\"action\":\"catch\",\"params\":[180.0,0.0]}");
+}
+
+TEST(ActionJsonTest, MatchesPrintfOneDecimal) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> value(-200.0f, 200.0f);
+    char expected[128];
+    char actual[ActionJson::MAX_SIZE];
+    for (int i = 0; i < 2000; ++i) {
+        Action action = Action::kick(value(rng), value(rng));
+        std::snprintf(expected, sizeof(expected), "{\"action\":\"kick\",\"params\":[%.1f,%.1f]}",
+                      action.params[0], action.params[1]);
+        size_t size = ActionJson::encode(action, actual, sizeof(actual));
+        ASSERT_EQ(std::string(actual, size), expected) << action.params[0] << " " << action.params[1];
+    }
+}
+
+TEST(ActionJsonTest, RejectsSmallBufferAndClampsHugeValues) {
+    char buffer[ActionJson::MAX_SIZE];
+    EXPECT_EQ(ActionJson::encode(Action::dash(80.0f, 0.0f), buffer, 20), 0u);
+    
+    // El peor caso entra en MAX_SIZE
+    size_t size = ActionJson::encode(Action::catch_ball(-1e30f), buffer, sizeof(buffer));
+    EXPECT_EQ(std::string(buffer, size), "{\"action\":\"catch\",\"params\":[-100000000.0,0.0]}");
+}
+
+// =============================================================================
+// Tests de SensorJsonStream
+// =============================================================================
+
+#include "sensor_json_stream.h"
+
+namespace {
+
+const char* STREAM_SAMPLE =
+    "{\"status\": \"PLAYING\", \"role\": \"STRIKER_GK_SIM\", \"time\": 120, "
+    "\"sensors\": {\"ball\": {\"dist\": 10.5, \"angle\": -15.0}, "
+    "\"goal\": null, "
+    "\"extra\": {\"nested\": [1, [2, 3], {\"a\": null}], \"ok\": true, \"s\": \"x\\\"y\"}, "
+    "\"teammates\": [{\"id\": 2, \"dist\": 5.0, \"angle\": 20.0}, {\"id\": 300, \"dist\": 1, \"angle\": 0}], "
+    "\"flags\": [{\"name\": \"f c\", \"dist\": 15.2, \"angle\": 30}, "
+    "{\"name\": \"f x y\", \"dist\": 1.0, \"angle\": 0}, "
+    "{\"angle\": -4.5e1, \"name\": \"g r\", \"dist\": 40.5}], "
+    "\"lines\": [{\"name\": \"l r\", \"dist\": 20.5, \"angle\": -60}]}}";
+
+void expect_same_sensors(const SensorData& a, const SensorData& b) {
+    EXPECT_EQ(a.status, b.status);
+    EXPECT_EQ(a.role, b.role);
+    EXPECT_EQ(a.ball.visible, b.ball.visible);
+    EXPECT_EQ(a.ball.distance, b.ball.distance);
+    EXPECT_EQ(a.ball.angle, b.ball.angle);
+    EXPECT_EQ(a.goal.visible, b.goal.visible);
+    ASSERT_EQ(a.teammate_count, b.teammate_count);
+    for (uint8_t i = 0; i < a.teammate_count; ++i) {
+        EXPECT_EQ(a.teammates[i].player_id, b.teammates[i].player_id);
+        EXPECT_EQ(a.teammates[i].distance, b.teammates[i].distance);
+    }
+    ASSERT_EQ(a.flag_count, b.flag_count);
+    for (uint8_t i = 0; i < a.flag_count; ++i) {
+        EXPECT_EQ(a.flags[i].id, b.flags[i].id);
+        EXPECT_EQ(a.flags[i].distance, b.flags[i].distance);
+        EXPECT_EQ(a.flags[i].angle, b.flags[i].angle);
+    }
+    ASSERT_EQ(a.line_count, b.line_count);
+    for (uint8_t i = 0; i < a.line_count; ++i) {
+        EXPECT_EQ(a.lines[i].id, b.lines[i].id);
+        EXPECT_EQ(a.lines[i].angle, b.lines[i].angle);
+    }
+}
+
+} // namespace
+
+TEST(SensorJsonStreamTest, MatchesSensorJsonForEverySplit) {
+    std::string json = STREAM_SAMPLE;
+    SensorData expected;
+    ASSERT_TRUE(SensorJson::decode(json, expected));
+    
+    SensorJsonStream stream;
+    for (size_t split = 0; split <= json.size(); ++split) {
+        SensorData sensors;
+        stream.begin(sensors);
+        ASSERT_TRUE(stream.feed(json.data(), split)) << split;
+        ASSERT_TRUE(stream.feed(json.data() + split, json.size() - split)) << split;
+        ASSERT_TRUE(stream.finish()) << split;
+        expect_same_sensors(sensors, expected);
+    }
+}
+
+TEST(SensorJsonStreamTest, AcceptsOneByteChunks) {
+    std::string json = STREAM_SAMPLE;
+    SensorData expected;
+    ASSERT_TRUE(SensorJson::decode(json, expected));
+    
+    SensorData sensors;
+    SensorJsonStream stream;
+    stream.begin(sensors);
+    for (char ch : json) {
+        ASSERT_TRUE(stream.feed(&ch, 1));
+    }
+    ASSERT_TRUE(stream.finish());
+    expect_same_sensors(sensors, expected);
+    EXPECT_EQ(sensors.teammate_count, 1);  // id 300 fuera de rango
+    EXPECT_EQ(sensors.flag_count, 2);
+    EXPECT_FLOAT_EQ(sensors.flags[1].angle, -45.0f);
+}
+
+TEST(SensorJsonStreamTest, RejectsWhatSensorJsonRejects) {
+    const char* bad[] = {
+        "",
+        "{\"status\": \"PLAYING\"",
+        "{\"status\": \"PLAYING\"} trailing",
+        "{\"sensors\": {\"ball\": {\"dist\": abc, \"angle\": 0}}}",
+        "{\"sensors\": {\"ball\": {\"dist\": NaN, \"angle\": 0}}}",
+        "{\"sensors\": {\"ball\": {\"dist\": 1.0, \"angle\": -Infinity}}}",
+        "{\"sensors\": {\"flags\": [{\"name\": \"f c\", \"dist\": 1.0,]}}",
+        "{\"status: \"PLAYING\"}",
+        "{\"status\": 5}",
+        "{\"sensors\": {\"ball\": [1]}}",
+        "{\"sensors\": {\"teammates\": [{\"id\": 1}]]}",
+    };
+    SensorJsonStream stream;
+    for (const char* json : bad) {
+        SensorData sensors;
+        stream.begin(sensors);
+        stream.feed(json, std::strlen(json));
+        EXPECT_FALSE(stream.finish()) << json;
+        EXPECT_FALSE(SensorJson::decode(json, sensors)) << json;
+    }
+    
+    // Tras un error, begin() deja el parser listo para el mensaje siguiente
+    SensorData sensors;
+    stream.begin(sensors);
+    const char* ok = "{\"status\": \"FINISHED\"}";
+    stream.feed(ok, std::strlen(ok));
+    EXPECT_TRUE(stream.finish());
+    EXPECT_EQ(sensors.status, GameStatus::FINISHED);
+}
+
+// =============================================================================
+// Tests de Mailbox
+// =============================================================================
+
+#include "mailbox.h"
+#include <thread>
+
+TEST(MailboxTest, TakeReturnsOnlyTheLatestValue) {
+    Mailbox<int> mailbox;
+    EXPECT_EQ(mailbox.take(), nullptr);
+    
+    mailbox.write_buffer() = 1;
+    EXPECT_FALSE(mailbox.publish());
+    mailbox.write_buffer() = 2;
+    EXPECT_TRUE(mailbox.publish());  // 1 no llegó a tomarse
+    
+    const int* latest = mailbox.take();
+    ASSERT_NE(latest, nullptr);
+    EXPECT_EQ(*latest, 2);
+    EXPECT_EQ(mailbox.take(), nullptr);
+    EXPECT_EQ(mailbox.overwritten(), 1u);
+}
+
+TEST(MailboxTest, ProducerNeverWritesTheBufferBeingRead) {
+    Mailbox<int> mailbox;
+    mailbox.write_buffer() = 7;
+    mailbox.publish();
+    const int* held = mailbox.take();
+    
+    // Muchas publicaciones sin take: ninguna toca el buffer tomado
+    for (int i = 0; i < 10; ++i) {
+        mailbox.write_buffer() = 100 + i;
+        mailbox.publish();
+    }
+    EXPECT_EQ(*held, 7);
+    EXPECT_EQ(*mailbox.take(), 109);
+}
+
+TEST(MailboxTest, ConsumerSeesIncreasingConsistentValues) {
+    struct Sample {
+        uint32_t sequence;
+        uint32_t check;
+    };
+    constexpr uint32_t COUNT = 200000;
+    Mailbox<Sample> mailbox;
+    
+    std::thread producer([&mailbox] {
+        for (uint32_t i = 1; i <= COUNT; ++i) {
+            Sample& s = mailbox.write_buffer();
+            s.sequence = i;
+            s.check = ~i;
+            mailbox.publish();
+        }
+    });
+    
+    uint32_t last = 0;
+    uint32_t taken = 0;
+    bool consistent = true;
+    while (last < COUNT) {
+        if (const Sample* s = mailbox.take()) {
+            consistent = consistent && s->check == ~s->sequence && s->sequence > last;
+            last = s->sequence;
+            ++taken;
+        }
+    }
+    producer.join();
+    
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(taken + mailbox.overwritten(), COUNT);
+}
+
+// =============================================================================
+// Tests de SpscRing
+// =============================================================================
+
+#include "spsc_ring.h"
+
+TEST(SpscRingTest, FillsWrapsAndEmpties) {
+    SpscRing<int, 4> ring;
+    int value = 0;
+    EXPECT_TRUE(ring.empty());
+    EXPECT_FALSE(ring.pop(value));
+    
+    // Varias vueltas para cruzar el borde del buffer
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 4; ++i) {
+            EXPECT_TRUE(ring.push(round * 10 + i));
+        }
+        EXPECT_FALSE(ring.push(99));  // Lleno
+        for (int i = 0; i < 4; ++i) {
+            ASSERT_TRUE(ring.pop(value));
+            EXPECT_EQ(value, round * 10 + i);
+        }
+        EXPECT_TRUE(ring.empty());
+    }
+}
+
+TEST(SpscRingTest, DeliversEveryValueInOrderAcrossThreads) {
+    constexpr uint32_t COUNT = 200000;
+    SpscRing<uint32_t, 64> ring;
+    
+    std::thread producer([&ring] {
+        for (uint32_t i = 1; i <= COUNT; ++i) {
+            uint32_t value = i;
+            while (!ring.push(std::move(value))) {
+                std::this_thread::yield();
+            }
+        }
+    });
+    
+    uint32_t expected = 1;
+    bool in_order = true;
+    while (expected <= COUNT) {
+        uint32_t value;
+        if (ring.pop(value)) {
+            in_order = in_order && value == expected;
+            ++expected;
+        }
+    }
+    producer.join();
+    
+    EXPECT_TRUE(in_order);
+    EXPECT_TRUE(ring.empty());
+}
+
+// =============================================================================
+// Tests de AgentExecutor
+// =============================================================================
+
+#include "agent_executor.h"
+#include <stdexcept>
+
+TEST(AgentExecutorTest, RunsEveryTaskAcrossBatches) {
+    AgentExecutor executor(4);
+    std::atomic<int> runs[64] = {};
+    
+    for (int batch = 0; batch < 20; ++batch) {
+        for (size_t agent = 0; agent < 64; ++agent) {
+            executor.submit(agent, [&runs, agent] { runs[agent].fetch_add(1); });
+        }
+        executor.wait_idle();
+        // Tras wait_idle, cada agente completó su tarea del lote
+        for (size_t agent = 0; agent < 64; ++agent) {
+            ASSERT_EQ(runs[agent].load(), batch + 1);
+        }
+    }
+}
+
+TEST(AgentExecutorTest, IdleWorkersStealFromABlockedOne) {
+    AgentExecutor executor(4);
+    constexpr int FOLLOWERS = 50;
+    std::atomic<int> done{0};
+    std::atomic<bool> finished_in_time{false};
+    
+    // La primera tarea ocupa a su worker hasta que las demás de la misma
+    // afinidad terminen: sólo pueden hacerlo si otro worker las roba
+    executor.submit(0, [&done, &finished_in_time] {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (done.load() < FOLLOWERS && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        finished_in_time = done.load() == FOLLOWERS;
+    });
+    for (int i = 0; i < FOLLOWERS; ++i) {
+        executor.submit(0, [&done] { done.fetch_add(1); });
+    }
+    executor.wait_idle();
+    
+    EXPECT_TRUE(finished_in_time);
+    EXPECT_GT(executor.stolen(), 0u);
+}
+
+TEST(AgentExecutorTest, IdleGuardWaitsWhenTheBatchThrows) {
+    AgentExecutor executor(2);
+    std::atomic<int> done{0};
+    
+    // Una excepción a mitad del lote no debe dejar tareas corriendo tras el guard
+    try {
+        IdleGuard idle(&executor);
+        for (int i = 0; i < 8; ++i) {
+            executor.submit(i, [&done] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(5));
+                done.fetch_add(1);
+            });
+        }
+        throw std::runtime_error("submit failed");
+    } catch (const std::runtime_error&) {
+        EXPECT_EQ(done.load(), 8);
+    }
+    
+    IdleGuard no_executor(nullptr);  // Sin executor no hace nada
+}
+
+// =============================================================================
+// Tests de TeamRouter
+// =============================================================================
+
+#include "team_router.h"
+#include <string>
+
+namespace {
+
+struct RoutedAgent {
+    RoutedAgent(std::string_view agent_id, size_t agent_index) : id(agent_id), index(agent_index) {}
+    std::string id;
+    size_t index;
+};
+
+using TestRouter = TeamRouter<RoutedAgent, int>;
+
+TestRouter make_router(size_t max_agents) {
+    return TestRouter("game/state/", max_agents, [](std::string_view id, size_t index) {
+        return std::make_unique<RoutedAgent>(id, index);
+    });
+}
+
+} // namespace
+
+TEST(TeamRouterTest, ParsesStateTopics) {
+    EXPECT_EQ(TestRouter::id_from_topic("game/state/", "game/state/p7"), "p7");
+    EXPECT_EQ(TestRouter::id_from_topic("game/state/", "game/state/team_a/3"), "team_a/3");
+    EXPECT_TRUE(TestRouter::id_from_topic("game/state/", "game/state/").empty());
+    EXPECT_TRUE(TestRouter::id_from_topic("game/state/", "game/state").empty());
+    EXPECT_TRUE(TestRouter::id_from_topic("game/state/", "player/action/p7").empty());
+    EXPECT_TRUE(TestRouter::id_from_topic("game/state/", "game/states/p7").empty());
+    
+    TestRouter router = make_router(4);
+    EXPECT_EQ(router.add("player/action/p7", 1), Routed::NOT_STATE);
+    EXPECT_EQ(router.add("game/state/", 2), Routed::NOT_STATE);
+    EXPECT_EQ(router.size(), 0u);
+    
+    RoutedAgent* agent = router.agent_for("game/state/p7");
+    ASSERT_NE(agent, nullptr);
+    EXPECT_EQ(agent->id, "p7");
+    EXPECT_EQ(router.agent_for("game/state/p7"), agent);
+}
+
+TEST(TeamRouterTest, CapsTheNumberOfPlayers) {
+    TestRouter router = make_router(2);
+    EXPECT_EQ(router.add("game/state/a", 1), Routed::ADDED);
+    EXPECT_EQ(router.add("game/state/b", 2), Routed::ADDED);
+    EXPECT_EQ(router.add("game/state/c", 3), Routed::TOO_MANY);
+    EXPECT_EQ(router.agent_for("game/state/c"), nullptr);
+    
+    // Los ya admitidos siguen entrando; los índices son el orden de llegada
+    EXPECT_EQ(router.add("game/state/b", 4), Routed::ADDED);
+    EXPECT_EQ(router.size(), 2u);
+    EXPECT_EQ(router.agent_for("game/state/a")->index, 0u);
+    EXPECT_EQ(router.agent_for("game/state/b")->index, 1u);
+    EXPECT_EQ(router.batch().size(), 3u);
+}
+
+TEST(TeamRouterTest, KeepsTheNewestStatePerPlayer) {
+    TestRouter router = make_router(8);
+    router.add("game/state/a", 1);
+    router.add("game/state/b", 2);
+    router.add("game/state/a", 3);
+    router.add("game/state/a", 4);
+    router.add("game/state/c", 5);
+    
+    // Sólo el último de cada jugador decide; los anteriores quedan superados
+    std::vector<TestRouter::Entry>& batch = router.batch();
+    ASSERT_EQ(batch.size(), 5u);
+    const bool latest[] = {false, true, false, true, true};
+    for (size_t i = 0; i < batch.size(); ++i) {
+        EXPECT_EQ(batch[i].item, static_cast<int>(i) + 1);
+        EXPECT_EQ(batch[i].latest, latest[i]) << i;
+    }
+    EXPECT_EQ(batch[0].agent, batch[3].agent);
+    EXPECT_EQ(batch[0].agent->id, "a");
+    
+    // Un lote nuevo no arrastra las entradas del anterior
+    router.clear_batch();
+    EXPECT_TRUE(router.batch().empty());
+    router.add("game/state/a", 6);
+    ASSERT_EQ(router.batch().size(), 1u);
+    EXPECT_TRUE(router.batch()[0].latest);
+    EXPECT_EQ(router.size(), 3u);
+    
+    size_t agents = 0;
+    router.for_each_agent([&agents](const RoutedAgent&) { ++agents; });
+    EXPECT_EQ(agents, 3u);
+}